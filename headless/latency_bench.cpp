@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "wrapper_hand_tracking.pb.h"
+#include "handFrame.h"
+#include "handWire.h"
+#include "landmarkFilter.h"
+#include "syntheticHand.h"
+#include "ParticleSystem.h"
+#include "threadPool.h"
+
+/**
+ End-to-end latency benchmark for the hand tracking pipeline.
+
+ Runs every stage between the tracker and the screen in one process, one
+ frame at a time: encode (sender side) -> sendto over UDP loopback -> recv
+ -> decode -> landmark filter -> particle update with the landmarks as
+ attractors, the way ofApp uses them. Each stage is timed separately for
+ every frame, for each wire format (see handWire.h), and the result is
+ printed as JSON: p50/p99/p999/mean/max in nanoseconds and the throughput
+ each stage alone would sustain, per stage and end to end.
+
+ The hand motion comes from syntheticHand with a fixed seed and the frame
+ count is fixed, so two runs on the same machine do the same work and can
+ be compared to catch regressions. Each format gets a warmup first that
+ isn't counted.
+
+ Usage: hand_latency_bench [options]
+   --frames N            timed frames per format (default 20000)
+   --warmup N            untimed frames before those (default 1000)
+   --format NAME         protobuf | raw | quantized | all (default all)
+   --particles N         particles to update per frame, 0 to skip (default 10000)
+   --threads N           particle update threads (default 1)
+   --filter MODE         none | euro | kalman (default euro)
+   --seed N              seed for the motion and the particles (default 1)
+   --out FILE            write the JSON to FILE instead of stdout
+ */
+
+#define BENCH_VERSION 1
+#define BENCH_WIDTH 640
+#define BENCH_HEIGHT 480
+#define BENCH_FRAME_USEC 33333
+
+enum benchStage{
+    STAGE_ENCODE = 0,
+    STAGE_SEND,
+    STAGE_RECEIVE,
+    STAGE_DECODE,
+    STAGE_FILTER,
+    STAGE_PARTICLES,
+    STAGE_END_TO_END,
+    NUM_STAGES
+};
+
+static const char* STAGE_NAMES[NUM_STAGES] = {"encode", "send", "receive", "decode", "filter", "particles", "end_to_end"};
+
+struct benchConfig{
+    int frames = 20000;
+    int warmup = 1000;
+    int particles = 10000;
+    int threads = 1;
+    landmarkFilterMode filter = LANDMARK_FILTER_ONE_EURO;
+    uint32_t seed = 1;
+};
+
+struct benchResult{
+    handWireFormat format;
+    int bytes = 0;
+    int lost = 0;
+    float max_error = 0;            // largest landmark change across the wire
+    double elapsed_sec = 0;
+    std::vector<int64_t> ns[NUM_STAGES];
+};
+
+//--------------------------------------------------------------
+static inline int64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static int64_t wall_usec(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--frames N] [--warmup N] [--format protobuf|raw|quantized|all] [--particles N]\n"
+                    "       [--threads N] [--filter none|euro|kalman] [--seed N] [--out FILE]\n", name);
+}
+
+//--------------------------------------------------------------
+// a receiving socket on an ephemeral loopback port, and one to send to it
+static bool open_loopback(int& send_fd, int& recv_fd, struct sockaddr_in& addr){
+    recv_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    send_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (recv_fd < 0 || send_fd < 0)
+        return false;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(recv_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || getsockname(recv_fd, (struct sockaddr*)&addr, &len) != 0)
+        return false;
+    // loopback doesn't drop a lone datagram, but don't hang if it ever does
+    struct timeval timeout = {1, 0};
+    setsockopt(recv_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return true;
+}
+
+//--------------------------------------------------------------
+static benchResult run_format(handWireFormat format, const benchConfig& config, ParticleSystem* particles,
+                              int send_fd, int recv_fd, const struct sockaddr_in& addr){
+
+    benchResult result;
+    result.format = format;
+    for (auto& v : result.ns)
+        v.reserve(config.frames);
+
+    // every format sees the same hand and starts from the same particles
+    syntheticHand hand(config.seed);
+    landmarkFilter filter;
+    filter.setMode(config.filter);
+    if (particles){
+        particles->setSeed(config.seed);
+        particles->reset(PARTICLE_MODE_NEAREST_POINTS, BENCH_WIDTH, BENCH_HEIGHT);
+    }
+
+    ::mediapipe::WrapperHandTracking send_wrapper, receive_wrapper;
+    HandFrame sent, received;
+    char out[HAND_WIRE_MAX_SIZE];
+    char in[HAND_WIRE_MAX_SIZE];
+    float attract_x[NUM_HAND_LANDMARKS], attract_y[NUM_HAND_LANDMARKS];
+    ParticleFrameContext context;
+    context.mode = PARTICLE_MODE_NEAREST_POINTS;
+    context.width = BENCH_WIDTH;
+    context.height = BENCH_HEIGHT;
+    context.attract_x = attract_x;
+    context.attract_y = attract_y;
+
+    int64_t start = 0;
+    for (int i=0; i<config.warmup + config.frames; i++){
+        bool timed = i >= config.warmup;
+        if (i == config.warmup)
+            start = now_ns();
+
+        int64_t timestamp = (int64_t)i * BENCH_FRAME_USEC;
+        hand.pose(timestamp / 1000000.0, sent);
+        sent.timestamp_usec = timestamp;
+        sent.has_sequence = true;
+        sent.sequence_id = i;
+        sent.send_time_usec = wall_usec();
+
+        int64_t t0 = now_ns();
+        int size = encode_hand_frame(format, sent, out, sizeof(out), send_wrapper);
+        int64_t t1 = now_ns();
+        sendto(send_fd, out, size, 0, (const struct sockaddr*)&addr, sizeof(addr));
+        int64_t t2 = now_ns();
+        int n = recv(recv_fd, in, sizeof(in), 0);
+        int64_t t3 = now_ns();
+        if (n <= 0 || !decode_hand_frame_any(in, n, receive_wrapper, received)){
+            result.lost += timed;
+            continue;
+        }
+        int64_t t4 = now_ns();
+        filter.apply(received);
+        int64_t t5 = now_ns();
+        if (particles){
+            for (int j=0; j<received.num_landmarks; j++){
+                attract_x[j] = received.x[j] * BENCH_WIDTH;
+                attract_y[j] = received.y[j] * BENCH_HEIGHT;
+            }
+            context.num_attractors = received.num_landmarks;
+            context.time = timestamp / 1000000.0f;
+            particles->update(context);
+        }
+        int64_t t6 = now_ns();
+
+        if (!timed)
+            continue;
+        result.bytes = size;
+        int64_t times[NUM_STAGES] = {t1 - t0, t2 - t1, t3 - t2, t4 - t3, t5 - t4, t6 - t5, t6 - t0};
+        for (int s=0; s<NUM_STAGES; s++)
+            result.ns[s].push_back(times[s]);
+
+        // what the wire format costs in accuracy (the filter has already
+        // moved `received`, so compare against a fresh decode)
+        HandFrame check;
+        decode_hand_frame_any(in, n, receive_wrapper, check);
+        for (int j=0; j<check.num_landmarks; j++){
+            result.max_error = std::max(result.max_error, std::fabs(check.x[j] - sent.x[j]));
+            result.max_error = std::max(result.max_error, std::fabs(check.y[j] - sent.y[j]));
+            result.max_error = std::max(result.max_error, std::fabs(check.z[j] - sent.z[j]));
+        }
+    }
+    result.elapsed_sec = (now_ns() - start) / 1e9;
+    return result;
+}
+
+//--------------------------------------------------------------
+static void print_stage(FILE* out, const char* name, std::vector<int64_t>& ns, bool last){
+    std::sort(ns.begin(), ns.end());
+    int64_t p50 = 0, p99 = 0, p999 = 0, max = 0;
+    double mean = 0;
+    if (!ns.empty()){
+        // nearest rank
+        auto rank = [&](double p){ return ns[std::min(ns.size() - 1, (size_t)std::ceil(p * ns.size()) - (p > 0))]; };
+        p50 = rank(0.5);
+        p99 = rank(0.99);
+        p999 = rank(0.999);
+        max = ns.back();
+        for (int64_t v : ns)
+            mean += v;
+        mean /= ns.size();
+    }
+    fprintf(out, "        \"%s\": {\"p50_ns\": %lld, \"p99_ns\": %lld, \"p999_ns\": %lld, \"mean_ns\": %.0f, \"max_ns\": %lld, \"ops_per_sec\": %.0f}%s\n",
+            name, (long long)p50, (long long)p99, (long long)p999, mean, (long long)max,
+            mean > 0 ? 1e9 / mean : 0.0, last ? "" : ",");
+}
+
+//--------------------------------------------------------------
+static void print_json(FILE* out, const benchConfig& config, int threads, std::vector<benchResult>& results){
+    static const char* FILTER_NAMES[] = {"none", "euro", "kalman"};
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"hand_latency\",\n");
+    fprintf(out, "  \"version\": %d,\n", BENCH_VERSION);
+    fprintf(out, "  \"config\": {\"frames\": %d, \"warmup\": %d, \"particles\": %d, \"threads\": %d, \"filter\": \"%s\", \"seed\": %u, \"landmarks\": %d},\n",
+            config.frames, config.warmup, config.particles, threads, FILTER_NAMES[config.filter], config.seed, NUM_HAND_LANDMARKS);
+    fprintf(out, "  \"formats\": [\n");
+    for (size_t i=0; i<results.size(); i++){
+        benchResult& result = results[i];
+        int measured = result.ns[STAGE_END_TO_END].size();
+        fprintf(out, "    {\n");
+        fprintf(out, "      \"format\": \"%s\",\n", hand_wire_name(result.format));
+        fprintf(out, "      \"bytes\": %d,\n", result.bytes);
+        fprintf(out, "      \"frames\": %d,\n", measured);
+        fprintf(out, "      \"lost\": %d,\n", result.lost);
+        fprintf(out, "      \"max_error\": %.3g,\n", result.max_error);
+        fprintf(out, "      \"frames_per_sec\": %.0f,\n", result.elapsed_sec > 0 ? measured / result.elapsed_sec : 0.0);
+        fprintf(out, "      \"stages\": {\n");
+        for (int s=0; s<NUM_STAGES; s++)
+            print_stage(out, STAGE_NAMES[s], result.ns[s], s == NUM_STAGES - 1);
+        fprintf(out, "      }\n");
+        fprintf(out, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+//========================================================================
+int main(int argc, char** argv){
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    benchConfig config;
+    std::string format_name = "all";
+    std::string out_path;
+
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--frames" && has_value)             config.frames = std::max(1, atoi(argv[++i]));
+        else if (arg == "--warmup" && has_value)        config.warmup = std::max(0, atoi(argv[++i]));
+        else if (arg == "--format" && has_value)        format_name = argv[++i];
+        else if (arg == "--particles" && has_value)     config.particles = std::max(0, atoi(argv[++i]));
+        else if (arg == "--threads" && has_value)       config.threads = std::max(1, atoi(argv[++i]));
+        else if (arg == "--seed" && has_value)          config.seed = atoi(argv[++i]);
+        else if (arg == "--out" && has_value)           out_path = argv[++i];
+        else if (arg == "--filter" && has_value){
+            std::string mode = argv[++i];
+            if (mode == "none")         config.filter = LANDMARK_FILTER_NONE;
+            else if (mode == "euro")    config.filter = LANDMARK_FILTER_ONE_EURO;
+            else if (mode == "kalman")  config.filter = LANDMARK_FILTER_KALMAN;
+            else { usage(argv[0]); return EXIT_FAILURE; }
+        }
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    std::vector<handWireFormat> formats;
+    for (handWireFormat format : {HAND_WIRE_PROTOBUF, HAND_WIRE_RAW, HAND_WIRE_QUANTIZED}){
+        if (format_name == "all" || format_name == hand_wire_name(format))
+            formats.push_back(format);
+    }
+    if (formats.empty()){
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int send_fd, recv_fd;
+    struct sockaddr_in addr;
+    if (!open_loopback(send_fd, recv_fd, addr)){
+        perror("loopback socket");
+        return EXIT_FAILURE;
+    }
+
+    threadPool pool;
+    ParticleSystem particles;
+    if (config.particles > 0){
+        particles.setup(config.particles);
+        if (config.threads > 1){
+            pool.setup(config.threads);
+            particles.setThreadPool(&pool);
+        }
+    }
+
+    std::vector<benchResult> results;
+    for (handWireFormat format : formats){
+        fprintf(stderr, "%s...\n", hand_wire_name(format));
+        results.push_back(run_format(format, config, config.particles > 0 ? &particles : nullptr, send_fd, recv_fd, addr));
+    }
+
+    FILE* out = stdout;
+    if (!out_path.empty() && !(out = fopen(out_path.c_str(), "w"))){
+        perror(out_path.c_str());
+        return EXIT_FAILURE;
+    }
+    print_json(out, config, config.threads > 1 ? pool.getNumThreads() : 1, results);
+    if (out != stdout)
+        fclose(out);
+
+    close(send_fd);
+    close(recv_fd);
+    google::protobuf::ShutdownProtobufLibrary();
+    return EXIT_SUCCESS;
+}
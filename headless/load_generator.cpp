@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "wrapper_hand_tracking.pb.h"
+#include "handBackpressure.h"
+#include "handBatch.h"
+#include "shmRing.h"
+#include "syntheticHand.h"
+
+/**
+ Synthetic hand tracking stream, for stress testing receivers without a
+ webcam or a MediaPipe graph.
+
+ Animates N hands (see syntheticHand.h) and sends every frame the way
+ MyPassThroughCalculator does: landmarks copied one by one into a fresh
+ WrapperHandTracking, the rect alongside, sequence id and send time stamped
+ last, one datagram per frame (or several frames per datagram with --batch).
+ Each hand sends from its own socket, so multi-source receivers see
+ one sender per hand.
+
+ Usage: hand_load_generator [options]
+   --hands N             hands to animate (default 1)
+   --rate HZ             frames per second per hand (default 30)
+   --host ADDR           where to send (default 127.0.0.1)
+   --port N              port to send to (default 8080)
+   --spread              send hand i to port N + i instead
+   --shm NAME            write to a shared memory ring instead of UDP
+   --duration SECS       stop after SECS seconds (default: run until Ctrl-C)
+   --seed N              seed for the motion (default 1)
+   --adaptive            slow down / send lean frames when the receiver says
+                         it's falling behind (see handBackpressure.h)
+   --batch MTU           pack each hand's frames into datagrams of up to MTU bytes (see handBatch.h)
+   --batch-flush MS      hold a frame at most MS milliseconds waiting for a batch (default 2)
+*/
+
+#define PORT 8080
+
+static volatile sig_atomic_t running = 1;
+
+//--------------------------------------------------------------
+static void on_signal(int){
+    running = 0;
+}
+
+//--------------------------------------------------------------
+static int64_t now_usec(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static int64_t wall_usec(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--hands N] [--rate HZ] [--host ADDR] [--port N] [--spread] [--shm NAME]\n"
+                    "       [--duration SECS] [--seed N] [--adaptive] [--batch MTU [--batch-flush MS]]\n", name);
+}
+
+//========================================================================
+int main(int argc, char** argv){
+
+    int num_hands = 1;
+    double rate = 30;
+    std::string host = "127.0.0.1";
+    int port = PORT;
+    bool spread = false;
+    std::string shm_name;
+    double duration = 0;
+    uint32_t seed = 1;
+    bool adaptive = false;
+    int batch_mtu = 0;
+    double batch_flush = HAND_BATCH_DEFAULT_FLUSH_USEC / 1000.0;
+
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--hands" && has_value)              num_hands = std::max(1, atoi(argv[++i]));
+        else if (arg == "--rate" && has_value)          rate = atof(argv[++i]);
+        else if (arg == "--host" && has_value)          host = argv[++i];
+        else if (arg == "--port" && has_value)          port = atoi(argv[++i]);
+        else if (arg == "--spread")                     spread = true;
+        else if (arg == "--shm" && has_value)           shm_name = argv[++i];
+        else if (arg == "--duration" && has_value)      duration = atof(argv[++i]);
+        else if (arg == "--seed" && has_value)          seed = atoi(argv[++i]);
+        else if (arg == "--adaptive")                   adaptive = true;
+        else if (arg == "--batch" && has_value)         batch_mtu = atoi(argv[++i]);
+        else if (arg == "--batch-flush" && has_value)   batch_flush = atof(argv[++i]);
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    if (rate <= 0){
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // one socket per hand (or one shared memory ring for all of them)
+    shmRing ring;
+    std::vector<int> fds;
+    std::vector<struct sockaddr_in> addrs(num_hands);
+    if (!shm_name.empty()){
+        if (!ring.setup(shm_name)){
+            fprintf(stderr, "%s\n", ring.getError().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    else{
+        for (int i=0; i<num_hands; i++){
+            struct sockaddr_in& addr = addrs[i];
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port + (spread ? i : 0));
+            if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1){
+                fprintf(stderr, "bad address: %s\n", host.c_str());
+                return EXIT_FAILURE;
+            }
+            int fd = socket(AF_INET, SOCK_DGRAM, 0);
+            if (fd < 0){
+                perror("socket");
+                return EXIT_FAILURE;
+            }
+            int buffer_size = 4 * 1024 * 1024;
+            setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+            fds.push_back(fd);
+        }
+    }
+
+    std::vector<syntheticHand> hands;
+    for (int i=0; i<num_hands; i++)
+        hands.emplace_back(seed * 1000 + i);
+    std::vector<uint64_t> sequence_ids(num_hands, 0);
+    std::vector<handBackpressure> backpressure(num_hands);
+    adaptive = adaptive && shm_name.empty();
+    std::vector<handBatcher> batchers(num_hands);
+    bool batching = batch_mtu > 0 && shm_name.empty();
+    for (auto& batcher : batchers)
+        batcher.setup(batch_mtu, (int64_t)(batch_flush * 1000));
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    if (shm_name.empty())
+        fprintf(stderr, "%d hands at %g Hz to %s:%d%s\n", num_hands, rate, host.c_str(), port, spread ? " and up" : "");
+    else
+        fprintf(stderr, "%d hands at %g Hz to %s\n", num_hands, rate, shm_name.c_str());
+
+    // hands are staggered across the frame period, so the load is even
+    int64_t period = std::max<int64_t>(1, (int64_t)(1000000 / rate));
+    int64_t start = now_usec();
+    std::vector<int64_t> due(num_hands);
+    for (int i=0; i<num_hands; i++)
+        due[i] = start + period * i / num_hands;
+
+    HandFrame frame;
+    ::mediapipe::NormalizedLandmarkList landmarks;
+    ::mediapipe::NormalizedRect rect;
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++)
+        landmarks.add_landmark();
+
+    uint64_t sent = 0, datagrams = 0, failed = 0, behind = 0, held_back = 0;
+    int64_t report_start = start;
+    while (running){
+
+        int hand = std::min_element(due.begin(), due.end()) - due.begin();
+        int64_t now = now_usec();
+        int64_t wake = due[hand];
+        if (batching){
+            // batches whose oldest frame has waited long enough go out first
+            for (int i=0; i<num_hands; i++){
+                if (batchers[i].needsFlush(now)){
+                    failed += sendto(fds[i], batchers[i].getData(), batchers[i].getSize(), 0, (const struct sockaddr *) &addrs[i], sizeof(addrs[i])) < 0;
+                    batchers[i].clear();
+                    datagrams++;
+                }
+                if (batchers[i].getDeadline() >= 0)
+                    wake = std::min(wake, batchers[i].getDeadline());
+            }
+        }
+        if (due[hand] > now){
+            // sleep for most of the wait, and spin the last stretch, since
+            // sleeps overshoot by tens of microseconds
+            if (wake - now > 200)
+                std::this_thread::sleep_for(std::chrono::microseconds(wake - now - 100));
+            continue;
+        }
+
+        // feedback comes back to the hand's socket
+        bool lean = false;
+        if (adaptive){
+            char feedback[256];
+            int n;
+            while ((n = recv(fds[hand], feedback, sizeof(feedback), MSG_DONTWAIT)) > 0)
+                backpressure[hand].onFeedback(feedback, n, now);
+            if (!backpressure[hand].shouldSend(now)){
+                held_back++;
+                due[hand] += period;
+                continue;
+            }
+            lean = backpressure[hand].useLeanEncoding();
+        }
+
+        // what the graph would hand the calculator for this frame
+        int64_t timestamp = due[hand] - start;
+        hands[hand].pose(timestamp / 1000000.0, frame);
+        for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+            auto* landmark = landmarks.mutable_landmark(i);
+            landmark->set_x(frame.x[i]);
+            landmark->set_y(frame.y[i]);
+            landmark->set_z(frame.z[i]);
+        }
+        rect.set_x_center(frame.rect_x_center);
+        rect.set_y_center(frame.rect_y_center);
+        rect.set_width(frame.rect_width);
+        rect.set_height(frame.rect_height);
+        rect.set_rotation(frame.rect_rotation);
+
+        // ...and what MyPassThroughCalculator::Process() does with it
+        ::mediapipe::WrapperHandTracking wrapper;
+        wrapper.set_timestamp_usec(timestamp);
+        for (int i = 0; i < landmarks.landmark_size(); ++i) {
+            const ::mediapipe::NormalizedLandmark& landmark = landmarks.landmark(i);
+            ::mediapipe::NormalizedLandmark* out = wrapper.mutable_landmarks()->add_landmark();
+            out->set_x(landmark.x());
+            out->set_y(landmark.y());
+            if (!lean)
+                out->set_z(landmark.z());
+        }
+        wrapper.mutable_rect()->set_x_center(rect.x_center());
+        wrapper.mutable_rect()->set_y_center(rect.y_center());
+        wrapper.mutable_rect()->set_width(rect.width());
+        wrapper.mutable_rect()->set_height(rect.height());
+        wrapper.mutable_rect()->set_rotation(rect.rotation());
+        wrapper.set_sequence_id(sequence_ids[hand]++);
+        wrapper.set_send_time_usec(wall_usec());
+
+        std::string msg_buffer;
+        wrapper.SerializeToString(&msg_buffer);
+        bool ok = true;
+        if (batching){
+            handBatcher& batcher = batchers[hand];
+            if (batcher.needsFlush(now, (int)msg_buffer.size())){
+                ok = sendto(fds[hand], batcher.getData(), batcher.getSize(), 0, (const struct sockaddr *) &addrs[hand], sizeof(addrs[hand])) >= 0;
+                batcher.clear();
+                datagrams++;
+            }
+            if (!batcher.add(msg_buffer.data(), (int)msg_buffer.size(), now)){
+                ok = sendto(fds[hand], msg_buffer.c_str(), msg_buffer.length(), 0, (const struct sockaddr *) &addrs[hand], sizeof(addrs[hand])) >= 0 && ok;
+                datagrams++;
+            }
+        }
+        else if (shm_name.empty()){
+            ok = sendto(fds[hand], msg_buffer.c_str(), msg_buffer.length(), 0, (const struct sockaddr *) &addrs[hand], sizeof(addrs[hand])) >= 0;
+            datagrams++;
+        }
+        else
+            ok = ring.send(msg_buffer.data(), msg_buffer.size(), hand);
+        sent++;
+        failed += !ok;
+
+        // a frame that's more than a period late is skipped, like a camera would
+        due[hand] += period;
+        if (now - due[hand] > period){
+            int64_t skipped = (now - due[hand]) / period;
+            due[hand] += skipped * period;
+            behind += skipped;
+        }
+
+        if (now - report_start >= 1000000){
+            fprintf(stderr, "%.0f msg/s  failed %llu  skipped %llu", sent / ((now - report_start) / 1000000.0),
+                    (unsigned long long)failed, (unsigned long long)behind);
+            if (adaptive)
+                fprintf(stderr, "  held back %llu  limit %.1f Hz%s", (unsigned long long)held_back,
+                        backpressure[0].getRateLimit(), backpressure[0].useLeanEncoding() ? "  lean" : "");
+            if (batching)
+                fprintf(stderr, "  %.0f datagrams/s", datagrams / ((now - report_start) / 1000000.0));
+            fprintf(stderr, "\n");
+            sent = datagrams = failed = behind = held_back = 0;
+            report_start = now;
+        }
+        if (duration > 0 && now - start >= duration * 1000000)
+            break;
+    }
+
+    if (batching){
+        for (int i=0; i<num_hands; i++)
+            if (batchers[i].getNumFrames() > 0)
+                sendto(fds[i], batchers[i].getData(), batchers[i].getSize(), 0, (const struct sockaddr *) &addrs[i], sizeof(addrs[i]));
+    }
+    for (int fd : fds)
+        close(fd);
+    ring.close();
+    return EXIT_SUCCESS;
+}
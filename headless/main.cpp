@@ -0,0 +1,826 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "wrapper_hand_tracking.pb.h"
+#include "handFrame.h"
+#include "landmarkFilter.h"
+#include "receiverStats.h"
+#include "udpReceiver.h"
+#include "multiSourceReceiver.h"
+#include "handCapture.h"
+#include "shmRing.h"
+#include "handTrace.h"
+#include "handMetrics.h"
+#include "handBackpressure.h"
+#include "handBatch.h"
+
+/**
+ Headless receiver for the MediaPipe hand tracking stream.
+ 
+ Runs the same receive -> decode -> stats -> filter path as ofApp, without a
+ window or an OpenGL context, so it can run on render-less hosts and in CI.
+ It can print frames, forward the raw datagrams elsewhere, and reports the
+ sustained decode throughput once a second.
+ 
+ It can also record the stream to a capture file and replay one, either
+ through the same decode path in place of the socket (deterministic: the
+ recorded receive times stand in for the clock) or as a stand-in sender
+ over UDP to another receiver, e.g. the openFrameworks app.
+ 
+ Usage: hand_receiver_headless [options]
+   --port N              port to listen on (default 8080)
+   --ports N,M,...       listen on several ports, one sender per port
+   --multicast GROUP:N   join a multicast group on port N
+   --shm NAME            read from a shared memory ring (see hand_load_generator)
+   --log                 print every decoded frame
+   --forward HOST:PORT   re-send each datagram to HOST:PORT (single port or replay)
+   --batch MTU           with --forward or --replay-to, pack frames into datagrams of up to MTU bytes
+   --batch-flush MS      hold a frame at most MS milliseconds waiting for a batch (default 2)
+   --filter MODE         none | euro | kalman (default none)
+   --duration SECS       stop after SECS seconds (default: run until Ctrl-C)
+   --bench-decode N      skip the network and decode a sample message N times
+   --record FILE         write every received frame to a capture file (gzipped if FILE ends in .gz),
+                         with its source id when there are several senders
+   --replay FILE         read frames from a capture file instead of the network
+   --speed N|max         replay N times as fast as recorded (default 1)
+   --loop                replay the capture over and over
+   --replay-to HOST:PORT with --replay, send the frames to HOST:PORT instead
+   --seek SECS           start the replay SECS into the capture (indexed captures)
+   --convert IN OUT      write capture IN as an indexed capture OUT, for seeking
+   --trace FILE          write receive/parse/filter spans as Chrome trace JSON on exit
+                         (single port or replay; needs a build with -DHAND_TRACE)
+   --metrics-file FILE   rewrite FILE with Prometheus metrics every second (single port or replay)
+   --metrics-socket PATH serve Prometheus metrics on a Unix domain socket (single port or replay)
+   --feedback            tell the sender how far behind we are, a few times a second (single port)
+ */
+
+#define PORT 8080
+
+static volatile sig_atomic_t running = 1;
+
+//--------------------------------------------------------------
+static void on_signal(int){
+    running = 0;
+}
+
+//--------------------------------------------------------------
+static int64_t now_usec(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static int64_t wall_usec(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--port N | --ports N,M,... | --multicast GROUP:N | --shm NAME] [--log] [--forward HOST:PORT] [--filter none|euro|kalman]\n"
+                    "       [--duration SECS] [--bench-decode N] [--record FILE]\n"
+                    "       [--replay FILE [--speed N|max] [--loop] [--seek SECS] [--replay-to HOST:PORT]]\n"
+                    "       [--convert IN OUT] [--trace FILE] [--metrics-file FILE] [--metrics-socket PATH]\n"
+                    "       [--feedback] [--batch MTU [--batch-flush MS]]\n", name);
+}
+
+//--------------------------------------------------------------
+static void log_frame(const HandFrame& frame, int64_t receive_wall){
+    printf("src %d  seq %llu  ts %lld  latency %.2fms  landmarks %d",
+           frame.source, (unsigned long long)frame.sequence_id, (long long)frame.timestamp_usec,
+           frame.send_time_usec ? (receive_wall - frame.send_time_usec) / 1000.0 : 0.0,
+           frame.num_landmarks);
+    if (frame.num_landmarks > 0)
+        printf("  wrist (%.3f, %.3f, %.3f)", frame.x[0], frame.y[0], frame.z[0]);
+    printf("\n");
+}
+
+//--------------------------------------------------------------
+static void print_stats(const receiverStats::Stats& stats, uint64_t messages, uint64_t bytes, int64_t decode_usec, int64_t elapsed_usec, uint64_t datagrams = 0){
+    double secs = elapsed_usec / 1000000.0;
+    // batched frames: show how few datagrams carried them
+    if (datagrams && datagrams < messages)
+        fprintf(stderr, "(%.0f datagrams/s)  ", datagrams / secs);
+    fprintf(stderr, "%.0f msg/s  %.2f MB/s  decode %.0f ns/msg  |  lost %llu (%.2f%%)  reordered %llu  dup %llu  jitter %.2fms  latency %.2fms\n",
+            messages / secs, bytes / secs / 1000000.0,
+            messages ? decode_usec * 1000.0 / messages : 0.0,
+            (unsigned long long)stats.lost, stats.loss_percent,
+            (unsigned long long)stats.reordered, (unsigned long long)stats.duplicates,
+            stats.jitter_usec / 1000.0, stats.latency_avg_usec / 1000.0);
+}
+
+//--------------------------------------------------------------
+// the sources after the first, when a multi-source capture is replayed;
+// ids that never sent anything are left out
+static void print_source_stats(const std::vector<receiverStats>& stats){
+    for (int i=1; i<(int)stats.size(); i++){
+        auto& s = stats[i].getStats();
+        if (s.received == 0 && s.duplicates == 0)
+            continue;
+        fprintf(stderr, "  [%d] received %llu  lost %llu (%.2f%%)  reordered %llu  jitter %.2fms  latency %.2fms\n",
+                i, (unsigned long long)s.received, (unsigned long long)s.lost, s.loss_percent,
+                (unsigned long long)s.reordered, s.jitter_usec / 1000.0, s.latency_avg_usec / 1000.0);
+    }
+}
+
+//--------------------------------------------------------------
+static bool parse_address(const std::string& address, struct sockaddr_in& addr){
+    size_t colon = address.rfind(':');
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(colon == std::string::npos ? PORT : atoi(address.c_str() + colon + 1));
+    return inet_pton(AF_INET, address.substr(0, colon).c_str(), &addr.sin_addr) == 1;
+}
+
+//--------------------------------------------------------------
+static void sleep_until(int64_t when_usec){
+    int64_t wait = when_usec - now_usec();
+    if (wait > 0)
+        std::this_thread::sleep_for(std::chrono::microseconds(std::min<int64_t>(wait, 100000)));
+}
+
+//--------------------------------------------------------------
+static int replay_to(handCaptureReplayer& replayer, const std::string& address, double duration, handBatcher* batcher){
+    
+    struct sockaddr_in addr;
+    if (!parse_address(address, addr)){
+        fprintf(stderr, "bad replay address: %s\n", address.c_str());
+        return EXIT_FAILURE;
+    }
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    
+    ::mediapipe::HandTrackingCaptureRecord record;
+    std::string buffer;
+    uint64_t datagrams = 0;
+    int64_t start = now_usec();
+    while (running && replayer.isOpen()){
+        int64_t now = now_usec();
+        if (batcher && batcher->needsFlush(now)){
+            sendto(fd, batcher->getData(), batcher->getSize(), 0, (const struct sockaddr *) &addr, sizeof(addr));
+            batcher->clear();
+            datagrams++;
+        }
+        if (!replayer.next(now, record)){
+            int64_t due = replayer.getNextDue();
+            if (batcher && batcher->getDeadline() >= 0)
+                due = std::min(due, batcher->getDeadline());
+            sleep_until(due);
+            continue;
+        }
+        
+        // stamp the send time so the receiver sees the recorded latency
+        auto* frame = record.mutable_frame();
+        if (frame->has_send_time_usec() && record.has_receive_wall_usec())
+            frame->set_send_time_usec(wall_usec() - (record.receive_wall_usec() - frame->send_time_usec()));
+        frame->SerializeToString(&buffer);
+        if (batcher && batcher->needsFlush(now, (int)buffer.size())){
+            sendto(fd, batcher->getData(), batcher->getSize(), 0, (const struct sockaddr *) &addr, sizeof(addr));
+            batcher->clear();
+            datagrams++;
+        }
+        if (!batcher || !batcher->add(buffer.data(), (int)buffer.size(), now)){
+            sendto(fd, buffer.data(), buffer.size(), 0, (const struct sockaddr *) &addr, sizeof(addr));
+            datagrams++;
+        }
+        
+        if (duration > 0 && now_usec() - start >= duration * 1000000)
+            break;
+    }
+    if (batcher && batcher->getNumFrames() > 0){
+        sendto(fd, batcher->getData(), batcher->getSize(), 0, (const struct sockaddr *) &addr, sizeof(addr));
+        datagrams++;
+    }
+    close(fd);
+    
+    fprintf(stderr, "replayed %llu frames in %llu datagrams in %.2fs\n", (unsigned long long)replayer.getNumReplayed(), (unsigned long long)datagrams, (now_usec() - start) / 1000000.0);
+    if (!replayer.getError().empty())
+        fprintf(stderr, "%s\n", replayer.getError().c_str());
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------
+static int convert_capture(const std::string& in_path, const std::string& out_path){
+    
+    handCaptureReader reader;
+    indexedCaptureWriter writer;
+    if (!reader.open(in_path)){
+        fprintf(stderr, "%s\n", reader.getError().c_str());
+        return EXIT_FAILURE;
+    }
+    if (!writer.open(out_path)){
+        fprintf(stderr, "%s\n", writer.getError().c_str());
+        return EXIT_FAILURE;
+    }
+    
+    ::mediapipe::HandTrackingCaptureRecord record;
+    while (reader.read(record)){
+        if (!writer.write(record))
+            break;
+    }
+    bool ok = writer.close();
+    if (!reader.getError().empty())
+        fprintf(stderr, "%s: %s, stopped after %llu records\n", in_path.c_str(), reader.getError().c_str(), (unsigned long long)writer.getNumRecords());
+    if (!ok){
+        fprintf(stderr, "%s\n", writer.getError().c_str());
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "wrote %llu records to %s\n", (unsigned long long)writer.getNumRecords(), out_path.c_str());
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------
+static int bench_decode(long iterations){
+    
+    // a typical message: 21 landmarks and a hand rect
+    ::mediapipe::WrapperHandTracking sample;
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+        auto* landmark = sample.mutable_landmarks()->add_landmark();
+        landmark->set_x(0.5f + 0.01f * i);
+        landmark->set_y(0.5f - 0.01f * i);
+        landmark->set_z(-0.001f * i);
+    }
+    sample.mutable_rect()->set_x_center(0.5f);
+    sample.mutable_rect()->set_y_center(0.5f);
+    sample.mutable_rect()->set_width(0.3f);
+    sample.mutable_rect()->set_height(0.3f);
+    sample.mutable_rect()->set_rotation(0.1f);
+    sample.set_timestamp_usec(1);
+    sample.set_sequence_id(1);
+    sample.set_send_time_usec(1);
+    std::string buffer;
+    sample.SerializeToString(&buffer);
+    
+    ::mediapipe::WrapperHandTracking wrapper;
+    HandFrame frame;
+    float sink = 0;
+    int64_t start = now_usec();
+    for (long i=0; i<iterations; i++){
+        if (!decode_hand_frame(buffer.data(), (int)buffer.size(), wrapper, frame))
+            return EXIT_FAILURE;
+        sink += frame.x[0];
+    }
+    int64_t elapsed = now_usec() - start;
+    
+    printf("decoded %ld messages of %zu bytes in %.3fs: %.0f msg/s, %.1f ns/msg (%g)\n",
+           iterations, buffer.size(), elapsed / 1000000.0,
+           iterations / (elapsed / 1000000.0), elapsed * 1000.0 / iterations, sink);
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------
+static int run_multi_source(multiSourceReceiver& receiver, handCaptureWriter& writer, bool log, landmarkFilterMode filter_mode, double duration){
+    
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    
+    std::vector<landmarkFilter> filters;
+    HandFrame frame;
+    uint64_t messages = 0;
+    int64_t start = now_usec();
+    int64_t report_start = start;
+    
+    while (running){
+        int n = receiver.poll(100);
+        if (n < 0){
+            fprintf(stderr, "%s\n", receiver.getError().c_str());
+            return EXIT_FAILURE;
+        }
+        messages += n;
+        
+        // hand out frames one source at a time
+        while (receiver.next(frame)){
+            while ((int)filters.size() <= frame.source){
+                filters.emplace_back();
+                filters.back().setMode(filter_mode);
+            }
+            if (filters[frame.source].apply(frame) && log)
+                log_frame(frame, wall_usec());
+        }
+        
+        int64_t now = now_usec();
+        if (now - report_start >= 1000000){
+            fprintf(stderr, "%.0f msg/s from %d sources\n", messages / ((now - report_start) / 1000000.0), receiver.getNumActiveSources());
+            for (int i=0; i<receiver.getNumSources(); i++){
+                auto& source = receiver.getSource(i);
+                if (!source.active)
+                    continue;
+                auto& stats = source.stats.getStats();
+                fprintf(stderr, "  [%d] %s  received %llu  lost %llu (%.2f%%)  reordered %llu  overwritten %llu  jitter %.2fms\n",
+                        source.id, source.name.c_str(), (unsigned long long)stats.received,
+                        (unsigned long long)stats.lost, stats.loss_percent, (unsigned long long)stats.reordered,
+                        (unsigned long long)source.overwritten, stats.jitter_usec / 1000.0);
+            }
+            messages = 0;
+            report_start = now;
+        }
+        if (duration > 0 && now - start >= duration * 1000000)
+            break;
+    }
+    if (writer.isOpen()){
+        writer.close();
+        fprintf(stderr, "recorded %llu frames\n", (unsigned long long)writer.getNumRecords());
+    }
+    return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------
+static int run_shm(shmRing& ring, handCaptureWriter& writer, bool log, landmarkFilterMode filter_mode, double duration){
+    
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    
+    // one set of stats and one filter per source, as with several sockets
+    std::vector<receiverStats> stats;
+    std::vector<landmarkFilter> filters;
+    ::mediapipe::WrapperHandTracking wrapper;
+    HandFrame frame;
+    static char buffer[100000];
+    uint64_t messages = 0, bytes = 0, parse_failures = 0, bad_sources = 0;
+    int64_t decode_usec = 0;
+    int64_t start = now_usec();
+    int64_t report_start = start;
+    int idle = 0;
+    
+    while (running){
+        int source;
+        int n = ring.receive(buffer, sizeof(buffer), &source);
+        int64_t now = now_usec();
+        
+        // nothing waiting: spin a little, then back off to short sleeps
+        if (n == 0){
+            if (++idle > 1000)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        else if (n > 0 && (source < 0 || source >= MULTI_SOURCE_MAX_SOURCES)){
+            // the source number is whatever the writer put in the ring: keep
+            // to as many senders as multiSourceReceiver tracks
+            idle = 0;
+            bad_sources++;
+        }
+        else if (n > 0){
+            idle = 0;
+            int64_t decode_start = now_usec();
+            bool ok = decode_hand_frame(buffer, n, wrapper, frame);
+            decode_usec += now_usec() - decode_start;
+            messages++;
+            bytes += n;
+            
+            if (!ok){
+                parse_failures++;
+            }
+            else{
+                while ((int)stats.size() <= source){
+                    stats.emplace_back();
+                    filters.emplace_back();
+                    filters.back().setMode(filter_mode);
+                }
+                frame.source = source;
+                frame.receive_usec = now;
+                int64_t now_wall = wall_usec();
+                if (writer.isOpen())
+                    writer.write(wrapper, now, now_wall, source);
+                if (stats[source].record(frame, now, now_wall) && filters[source].apply(frame) && log)
+                    log_frame(frame, now_wall);
+            }
+        }
+        
+        if (now - report_start >= 1000000){
+            double secs = (now - report_start) / 1000000.0;
+            int heard = 0;
+            for (auto& source : stats)
+                heard += source.getStats().received > 0;
+            fprintf(stderr, "%.0f msg/s  %.2f MB/s  decode %.0f ns/msg  from %d sources  |  ring dropped %llu\n",
+                    messages / secs, bytes / secs / 1000000.0, messages ? decode_usec * 1000.0 / messages : 0.0,
+                    heard, (unsigned long long)ring.getDropped());
+            for (int i=0; i<(int)stats.size(); i++){
+                auto& s = stats[i].getStats();
+                if (s.received == 0 && s.duplicates == 0)
+                    continue;
+                fprintf(stderr, "  [%d] received %llu  lost %llu (%.2f%%)  reordered %llu  jitter %.2fms  latency %.2fms\n",
+                        i, (unsigned long long)s.received, (unsigned long long)s.lost, s.loss_percent,
+                        (unsigned long long)s.reordered, s.jitter_usec / 1000.0, s.latency_avg_usec / 1000.0);
+            }
+            if (parse_failures)
+                fprintf(stderr, "  %llu messages failed to parse\n", (unsigned long long)parse_failures);
+            if (bad_sources)
+                fprintf(stderr, "  %llu messages dropped, source out of range\n", (unsigned long long)bad_sources);
+            messages = bytes = parse_failures = bad_sources = 0;
+            decode_usec = 0;
+            report_start = now;
+        }
+        if (duration > 0 && now - start >= duration * 1000000)
+            break;
+    }
+    ring.close(true);
+    if (writer.isOpen()){
+        writer.close();
+        fprintf(stderr, "recorded %llu frames\n", (unsigned long long)writer.getNumRecords());
+    }
+    return EXIT_SUCCESS;
+}
+
+//========================================================================
+int main(int argc, char** argv){
+    
+    int port = PORT;
+    bool log = false;
+    std::string forward;
+    landmarkFilterMode filter_mode = LANDMARK_FILTER_NONE;
+    double duration = 0;
+    long bench_iterations = 0;
+    std::vector<int> ports;
+    std::string multicast;
+    std::string shm_name;
+    std::string record_path;
+    std::string replay_path;
+    std::string replay_address;
+    double speed = 1;
+    double seek = 0;
+    bool loop = false;
+    std::string convert_in, convert_out;
+    std::string trace_path;
+    std::string metrics_file, metrics_socket;
+    bool send_feedback = false;
+    int batch_mtu = 0;
+    double batch_flush = HAND_BATCH_DEFAULT_FLUSH_USEC / 1000.0;
+    
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--port" && has_value)               port = atoi(argv[++i]);
+        else if (arg == "--multicast" && has_value)     multicast = argv[++i];
+        else if (arg == "--shm" && has_value)           shm_name = argv[++i];
+        else if (arg == "--ports" && has_value){
+            for (const char* p = argv[++i]; *p; ){
+                ports.push_back(atoi(p));
+                const char* comma = strchr(p, ',');
+                p = comma ? comma + 1 : p + strlen(p);
+            }
+        }
+        else if (arg == "--log")                        log = true;
+        else if (arg == "--forward" && has_value)       forward = argv[++i];
+        else if (arg == "--duration" && has_value)      duration = atof(argv[++i]);
+        else if (arg == "--bench-decode" && has_value)  bench_iterations = atol(argv[++i]);
+        else if (arg == "--record" && has_value)        record_path = argv[++i];
+        else if (arg == "--replay" && has_value)        replay_path = argv[++i];
+        else if (arg == "--replay-to" && has_value)     replay_address = argv[++i];
+        else if (arg == "--loop")                       loop = true;
+        else if (arg == "--seek" && has_value)          seek = atof(argv[++i]);
+        else if (arg == "--trace" && has_value)         trace_path = argv[++i];
+        else if (arg == "--metrics-file" && has_value)  metrics_file = argv[++i];
+        else if (arg == "--metrics-socket" && has_value) metrics_socket = argv[++i];
+        else if (arg == "--feedback")                   send_feedback = true;
+        else if (arg == "--batch" && has_value)         batch_mtu = atoi(argv[++i]);
+        else if (arg == "--batch-flush" && has_value)   batch_flush = atof(argv[++i]);
+        else if (arg == "--convert" && i + 2 < argc){
+            convert_in = argv[++i];
+            convert_out = argv[++i];
+        }
+        else if (arg == "--speed" && has_value){
+            std::string value = argv[++i];
+            speed = value == "max" ? 0 : atof(value.c_str());
+        }
+        else if (arg == "--filter" && has_value){
+            std::string mode = argv[++i];
+            if (mode == "none")         filter_mode = LANDMARK_FILTER_NONE;
+            else if (mode == "euro")    filter_mode = LANDMARK_FILTER_ONE_EURO;
+            else if (mode == "kalman")  filter_mode = LANDMARK_FILTER_KALMAN;
+            else { usage(argv[0]); return EXIT_FAILURE; }
+        }
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    
+    // the shared memory and multi-source loops only decode, log, filter and record
+    if (replay_path.empty() && (!shm_name.empty() || !ports.empty() || !multicast.empty()) &&
+        (!forward.empty() || batch_mtu > 0 || !trace_path.empty() || !metrics_file.empty() || !metrics_socket.empty() || send_feedback)){
+        fprintf(stderr, "--forward, --batch, --trace, --metrics-file, --metrics-socket and --feedback need a single --port\n");
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    if (bench_iterations > 0)
+        return bench_decode(bench_iterations);
+    if (!convert_in.empty())
+        return convert_capture(convert_in, convert_out);
+    
+    // optional batching, for whatever we send on
+    handBatcher batcher;
+    if (batch_mtu > 0)
+        batcher.setup(batch_mtu, (int64_t)(batch_flush * 1000));
+    
+    handCaptureReplayer replayer;
+    if (!replay_path.empty()){
+        replayer.setSpeed(speed);
+        replayer.setLoop(loop);
+        if (!replayer.open(replay_path)){
+            fprintf(stderr, "%s\n", replayer.getError().empty() ? ("nothing to replay in " + replay_path).c_str() : replayer.getError().c_str());
+            return EXIT_FAILURE;
+        }
+        if (seek > 0 && !replayer.seek(seek * 1000000)){
+            fprintf(stderr, "can't seek in %s: only indexed captures can (see --convert)\n", replay_path.c_str());
+            return EXIT_FAILURE;
+        }
+        if (!replay_address.empty())
+            return replay_to(replayer, replay_address, duration, batch_mtu > 0 ? &batcher : nullptr);
+    }
+    
+    handCaptureWriter writer;
+    if (!record_path.empty()){
+        bool gzip = record_path.size() > 3 && record_path.compare(record_path.size() - 3, 3, ".gz") == 0;
+        if (!writer.open(record_path, gzip)){
+            fprintf(stderr, "%s\n", writer.getError().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    
+    // a local sender, through shared memory
+    if (replay_path.empty() && !shm_name.empty()){
+        shmRing ring;
+        if (!ring.setup(shm_name)){
+            fprintf(stderr, "%s\n", ring.getError().c_str());
+            return EXIT_FAILURE;
+        }
+        fprintf(stderr, "reading %s\n", shm_name.c_str());
+        return run_shm(ring, writer, log, filter_mode, duration);
+    }
+    
+    // several senders: one epoll loop over all sockets
+    if (replay_path.empty() && (!ports.empty() || !multicast.empty())){
+        multiSourceReceiver receiver;
+        bool ok;
+        if (!multicast.empty()){
+            size_t colon = multicast.rfind(':');
+            int group_port = colon == std::string::npos ? PORT : atoi(multicast.c_str() + colon + 1);
+            ok = receiver.setupMulticast(multicast.substr(0, colon), group_port);
+        }
+        else{
+            ok = receiver.setup(ports);
+        }
+        if (!ok){
+            fprintf(stderr, "%s\n", receiver.getError().c_str());
+            return EXIT_FAILURE;
+        }
+        if (writer.isOpen())
+            receiver.setCapture(&writer);
+        return run_multi_source(receiver, writer, log, filter_mode, duration);
+    }
+    
+    handTrace::setProcessName("receiver (headless)");
+    HAND_TRACE_THREAD("main");
+    
+    // blocking socket with a short timeout, so we wake up to print stats
+    // (unless a capture is replayed in its place)
+    udpReceiver receiver;
+    if (replay_path.empty()){
+        if (!receiver.setup(port, true, 4 * 1024 * 1024)){
+            fprintf(stderr, "%s\n", receiver.getError().c_str());
+            return EXIT_FAILURE;
+        }
+        struct timeval timeout = {0, 100000};
+        // forwarded batches have to go out by their deadline, even when nothing comes in
+        if (!forward.empty() && batch_mtu > 0)
+            timeout.tv_usec = std::max<int64_t>(1000, std::min<int64_t>(100000, (int64_t)(batch_flush * 1000)));
+        setsockopt(receiver.getFd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    
+    // optional forwarding socket
+    int forward_fd = -1;
+    struct sockaddr_in forward_addr;
+    if (!forward.empty()){
+        if (!parse_address(forward, forward_addr)){
+            fprintf(stderr, "bad forward address: %s\n", forward.c_str());
+            return EXIT_FAILURE;
+        }
+        forward_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    }
+    
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    if (replay_path.empty())
+        fprintf(stderr, "listening on port %d\n", port);
+    else
+        fprintf(stderr, "replaying %s\n", replay_path.c_str());
+    
+    ::mediapipe::WrapperHandTracking wrapper;
+    HandFrame frame;
+    // stats and a filter per source: live there's only one, but a capture
+    // recorded from several senders replays with their source ids
+    std::vector<receiverStats> receive_stats(1);
+    std::vector<landmarkFilter> filters(1);
+    filters[0].setMode(filter_mode);
+    
+    // declared before the registry, so they outlive its export thread
+    metricCounter metric_frames, metric_datagrams, metric_bytes, metric_parse_failures;
+    metricGauge metric_lost;
+    metricHistogram metric_receive, metric_parse, metric_filter;
+    handMetrics metrics;
+    metrics.add(&metric_frames, "hand_receiver_frames", "Frames received, counting each one in a batch");
+    metrics.add(&metric_datagrams, "hand_receiver_datagrams", "Datagrams received");
+    metrics.add(&metric_bytes, "hand_receiver_bytes", "Bytes received");
+    metrics.add(&metric_parse_failures, "hand_receiver_parse_failures", "Frames that didn't parse");
+    metrics.add(&metric_lost, "hand_receiver_frames_lost", "Frames lost in transit, by sequence id");
+    metrics.add(&metric_receive, "hand_receiver_receive", "Time blocked in receive, per call");
+    metrics.add(&metric_parse, "hand_receiver_parse", "Time to parse one frame");
+    metrics.add(&metric_filter, "hand_receiver_filter", "Time to filter one frame");
+    if ((!metrics_file.empty() && !metrics.serveFile(metrics_file)) ||
+        (!metrics_socket.empty() && !metrics.serveSocket(metrics_socket))){
+        fprintf(stderr, "%s\n", metrics.getError().c_str());
+        return EXIT_FAILURE;
+    }
+    
+    // backpressure: how many frames and datagrams we read back to back, and
+    // what we used
+    handFeedback feedback;
+    std::string feedback_datagram;
+    int queue_frames = 0, queue_datagrams = 0;
+    send_feedback = send_feedback && replay_path.empty();
+    
+    static char buffer[100000];
+    uint64_t messages = 0, datagrams = 0, bytes = 0, parse_failures = 0, bad_sources = 0;
+    int64_t decode_ns = 0;
+    int64_t start = now_usec();
+    int64_t report_start = start;
+    ::mediapipe::HandTrackingCaptureRecord record;
+    std::string replayed;
+    handBatchReader batch;
+    const char* message;
+    int size;
+    
+    while (running){
+        int n;
+        int64_t now, now_wall;
+        int source = 0;
+        
+        // a replayed frame goes through the same decode as a received one,
+        // with the recorded receive times instead of the clock
+        if (!replay_path.empty()){
+            if (!replayer.isOpen())
+                break;
+            n = 0;
+            now = now_usec();
+            now_wall = wall_usec();
+            if (replayer.next(now, record)){
+                // source ids come from the file, so keep to the same bound
+                if (record.source() < 0 || record.source() >= MULTI_SOURCE_MAX_SOURCES){
+                    bad_sources++;
+                    continue;
+                }
+                record.frame().SerializeToString(&replayed);
+                n = std::min(replayed.size(), sizeof(buffer));
+                memcpy(buffer, replayed.data(), n);
+                now = record.receive_usec();
+                source = record.source();
+                if (record.has_receive_wall_usec())
+                    now_wall = record.receive_wall_usec();
+            }
+            else{
+                sleep_until(replayer.getNextDue());
+            }
+        }
+        else{
+            HAND_TRACE_SCOPE("receive");
+            metricTimer timer(metric_receive);
+            n = receiver.receive(buffer, sizeof(buffer));
+            now = now_usec();
+            now_wall = wall_usec();
+        }
+        
+        if (n < 0){
+            fprintf(stderr, "%s\n", receiver.getError().c_str());
+            break;
+        }
+        if (forward_fd >= 0 && batch_mtu > 0 && batcher.needsFlush(now)){
+            sendto(forward_fd, batcher.getData(), batcher.getSize(), 0, (const struct sockaddr *) &forward_addr, sizeof(forward_addr));
+            batcher.clear();
+        }
+        if (n > 0){
+            if (forward_fd >= 0 && batch_mtu == 0)
+                sendto(forward_fd, buffer, n, 0, (const struct sockaddr *) &forward_addr, sizeof(forward_addr));
+            
+            // every frame in the datagram, in one pass
+            uint64_t datagram_start = messages;
+            batch.reset(buffer, n);
+            while (batch.next(message, size)){
+                metric_frames.add();
+                if (forward_fd >= 0 && batch_mtu > 0){
+                    if (batcher.needsFlush(now, size)){
+                        sendto(forward_fd, batcher.getData(), batcher.getSize(), 0, (const struct sockaddr *) &forward_addr, sizeof(forward_addr));
+                        batcher.clear();
+                    }
+                    if (!batcher.add(message, size, now))
+                        sendto(forward_fd, message, size, 0, (const struct sockaddr *) &forward_addr, sizeof(forward_addr));
+                }
+                
+                int64_t decode_start = handTrace::now_ns();
+                bool ok;
+                {
+                    HAND_TRACE_SCOPE("parse");
+                    ok = decode_hand_frame(message, size, wrapper, frame);
+                }
+                int64_t decode_end = handTrace::now_ns();
+                decode_ns += decode_end - decode_start;
+                metric_parse.record(decode_end - decode_start);
+                
+                if (!ok){
+                    parse_failures++;
+                    metric_parse_failures.add();
+                }
+                else{
+                    while ((int)receive_stats.size() <= source){
+                        receive_stats.emplace_back();
+                        filters.emplace_back();
+                        filters.back().setMode(filter_mode);
+                    }
+                    frame.source = source;
+                    frame.receive_usec = now;
+                    if (writer.isOpen())
+                        writer.write(wrapper, now, now_wall, source);
+                    if (receive_stats[source].record(frame, now, now_wall)){
+                        bool filtered;
+                        {
+                            HAND_TRACE_SCOPE("filter");
+                            metricTimer timer(metric_filter);
+                            filtered = filters[source].apply(frame);
+                        }
+                        if (filtered && log)
+                            log_frame(frame, now_wall);
+                        feedback.consumed();
+                    }
+                }
+                messages++;
+            }
+            if (send_feedback){
+                queue_frames += (int)(messages - datagram_start);
+                queue_datagrams++;
+                if (!receiver.hasPending()){
+                    feedback.received(queue_frames, queue_datagrams);
+                    queue_frames = queue_datagrams = 0;
+                }
+            }
+            datagrams++;
+            bytes += n;
+            metric_datagrams.add();
+            metric_bytes.add(n);
+            metric_lost.set(receive_stats[0].getStats().lost);
+        }
+        
+        // report on the real clock, even when replaying
+        now = now_usec();
+        if (send_feedback && feedback.update(now, receive_stats[0].getStats().received, receive_stats[0].getStats().lost, feedback_datagram))
+            receiver.reply(feedback_datagram.data(), (int)feedback_datagram.size());
+        if (now - report_start >= 1000000){
+            print_stats(receive_stats[0].getStats(), messages, bytes, decode_ns / 1000, now - report_start, datagrams);
+            print_source_stats(receive_stats);
+            if (parse_failures)
+                fprintf(stderr, "  %llu messages failed to parse\n", (unsigned long long)parse_failures);
+            messages = datagrams = bytes = parse_failures = 0;
+            decode_ns = 0;
+            report_start = now;
+        }
+        if (duration > 0 && now - start >= duration * 1000000)
+            break;
+    }
+    
+    if (!replay_path.empty()){
+        if (messages)
+            print_stats(receive_stats[0].getStats(), messages, bytes, decode_ns / 1000, std::max<int64_t>(1, now_usec() - report_start));
+        print_source_stats(receive_stats);
+        fprintf(stderr, "replayed %llu frames\n", (unsigned long long)replayer.getNumReplayed());
+        if (bad_sources)
+            fprintf(stderr, "skipped %llu frames with a source id out of range\n", (unsigned long long)bad_sources);
+        if (!replayer.getError().empty())
+            fprintf(stderr, "%s\n", replayer.getError().c_str());
+    }
+    if (writer.isOpen()){
+        writer.close();
+        fprintf(stderr, "recorded %llu frames to %s\n", (unsigned long long)writer.getNumRecords(), record_path.c_str());
+    }
+    if (forward_fd >= 0){
+        if (batcher.getNumFrames() > 0)
+            sendto(forward_fd, batcher.getData(), batcher.getSize(), 0, (const struct sockaddr *) &forward_addr, sizeof(forward_addr));
+        close(forward_fd);
+    }
+    if (!trace_path.empty()){
+        if (!handTrace::isEnabled())
+            fprintf(stderr, "tracing is off: build with -DHAND_TRACE\n");
+        else if (!handTrace::write(trace_path))
+            fprintf(stderr, "can't write %s\n", trace_path.c_str());
+        else
+            fprintf(stderr, "wrote trace to %s\n", trace_path.c_str());
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,562 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "nearestAttractor.h"
+#include "noiseField.h"
+#include "ParticleSystem.h"
+#include "threadPool.h"
+
+/**
+ Micro-benchmarks for the particle update kernels.
+
+ nearest/...: find_nearest_attractors() with each kernel it can pick (the
+ plain loop ParticleSystem used to run inline, SSE2 and AVX2), over the
+ particles in the 256-particle blocks ParticleSystem hands it, for one and
+ two hands' worth of attractors. Kernels the CPU doesn't support are
+ skipped, and every kernel's answer is checked against the plain loop's.
+
+ snow/... and wander/...: the noise-driven forces (the falling snow mode,
+ and the drift particles away from the hand do in the repel and nearest
+ modes), once evaluating simplex noise per particle the way ofSignedNoise
+ did before noiseField, and once sampling the precomputed noiseField.
+
+ system/...: a whole ParticleSystem::update() in each mode, single
+ threaded, with two hands of attractors for the nearest points mode.
+
+ threads/...: ParticleSystem::update() in the attract and nearest points
+ modes over 100k and 1M particles (regardless of --particles), on a
+ threadPool of 1, 2, 4, 8 and 16 threads. The speedup column is against
+ the one thread run of the same mode and size; on a machine with fewer
+ cores than threads it shows the cost of oversubscribing instead.
+
+ Same harness as wrapper_bench: each case is calibrated to run for
+ --min-time, then repeated and the median kept. One op is one pass over
+ all the particles.
+
+ Usage: hand_particle_bench [options]
+   --particles N         particles per pass (default 100000)
+   --filter TEXT         only run cases whose name contains TEXT
+   --min-time SECS       time per repetition (default 0.1)
+   --repetitions N       repetitions per case, the median is reported (default 5)
+   --json FILE           also write the results as JSON to FILE
+ */
+
+#define BENCH_VERSION 1
+#define BENCH_WIDTH 1280
+#define BENCH_HEIGHT 720
+
+// what ParticleSystem::update_nearest_points() passes per call
+#define NEAREST_BLOCK 256
+
+// the thread counts and particle counts the scaling cases sweep
+static const int THREAD_COUNTS[] = {1, 2, 4, 8, 16};
+static const int THREAD_SWEEP_PARTICLES[] = {100000, 1000000};
+
+// runs the operation `iterations` times and returns the nanoseconds spent
+typedef std::function<int64_t(int64_t iterations)> benchFunction;
+
+struct benchWorkload{
+    std::string name;
+    std::vector<float> px, py;
+    std::vector<float> ax, ay;
+};
+
+// the particle arrays the force loops work on
+struct benchParticles{
+    std::vector<float> x, y, vx, vy, drag, uniqueVal;
+};
+
+struct benchResult{
+    std::string name;
+    std::string workload;
+    double ns_per_op = 0;
+    double min_ns_per_op = 0;
+    double ns_per_particle = 0;
+    int threads = 0;                    // threads/... cases only
+    double speedup = 0;                 // against the one thread run
+};
+
+//--------------------------------------------------------------
+static inline int64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+// stops the compiler from optimizing away a result
+template <class T>
+static inline void keep(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--particles N] [--filter TEXT] [--min-time SECS] [--repetitions N] [--json FILE]\n", name);
+}
+
+//--------------------------------------------------------------
+// particles scattered over the window, attractors bunched like a hand or two
+static void make_workload(benchWorkload& workload, int particles, int attractors){
+    workload.name = std::to_string(attractors) + "_attractors";
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> wx(0, BENCH_WIDTH), wy(0, BENCH_HEIGHT);
+    std::normal_distribution<float> spread(0, 60);
+    workload.px.resize(particles);
+    workload.py.resize(particles);
+    for (int i=0; i<particles; i++){
+        workload.px[i] = wx(rng);
+        workload.py[i] = wy(rng);
+    }
+    for (int j=0; j<attractors; j++){
+        float cx = BENCH_WIDTH * (j < 21 ? 0.35f : 0.65f);
+        workload.ax.push_back(cx + spread(rng));
+        workload.ay.push_back(BENCH_HEIGHT * 0.5f + spread(rng));
+    }
+}
+
+//--------------------------------------------------------------
+// Stefan Gustavson's simplex noise, which is what ofSignedNoise evaluates
+// (with a permutation table of our own; the cost is the same)
+static unsigned char perm[512];
+
+//--------------------------------------------------------------
+static void setup_simplex(){
+    std::mt19937 rng(1);
+    unsigned char p[256];
+    for (int i=0; i<256; i++)
+        p[i] = i;
+    std::shuffle(p, p + 256, rng);
+    for (int i=0; i<512; i++)
+        perm[i] = p[i & 255];
+}
+
+//--------------------------------------------------------------
+static inline int fast_floor(float x){
+    return x > 0 ? (int)x : (int)x - 1;
+}
+
+//--------------------------------------------------------------
+static inline float grad2(int hash, float x, float y){
+    int h = hash & 7;
+    float u = h < 4 ? x : y;
+    float v = h < 4 ? y : x;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
+}
+
+//--------------------------------------------------------------
+static inline float grad3(int hash, float x, float y, float z){
+    int h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+//--------------------------------------------------------------
+static float simplex_noise(float x, float y){
+    const float F2 = 0.366025403f, G2 = 0.211324865f;
+    float s = (x + y) * F2;
+    int i = fast_floor(x + s), j = fast_floor(y + s);
+    float t = (i + j) * G2;
+    float x0 = x - (i - t), y0 = y - (j - t);
+    int i1 = x0 > y0, j1 = !i1;
+    float x1 = x0 - i1 + G2, y1 = y0 - j1 + G2;
+    float x2 = x0 - 1 + 2 * G2, y2 = y0 - 1 + 2 * G2;
+    int ii = i & 255, jj = j & 255;
+
+    float n = 0;
+    float t0 = 0.5f - x0 * x0 - y0 * y0;
+    if (t0 > 0){ t0 *= t0; n += t0 * t0 * grad2(perm[ii + perm[jj]], x0, y0); }
+    float t1 = 0.5f - x1 * x1 - y1 * y1;
+    if (t1 > 0){ t1 *= t1; n += t1 * t1 * grad2(perm[ii + i1 + perm[jj + j1]], x1, y1); }
+    float t2 = 0.5f - x2 * x2 - y2 * y2;
+    if (t2 > 0){ t2 *= t2; n += t2 * t2 * grad2(perm[ii + 1 + perm[jj + 1]], x2, y2); }
+    return 40 * n;
+}
+
+//--------------------------------------------------------------
+static float simplex_noise(float x, float y, float z){
+    const float F3 = 0.333333333f, G3 = 0.166666667f;
+    float s = (x + y + z) * F3;
+    int i = fast_floor(x + s), j = fast_floor(y + s), k = fast_floor(z + s);
+    float t = (i + j + k) * G3;
+    float x0 = x - (i - t), y0 = y - (j - t), z0 = z - (k - t);
+
+    // which simplex we're in
+    int i1, j1, k1, i2, j2, k2;
+    if (x0 >= y0){
+        if (y0 >= z0)       { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+        else if (x0 >= z0)  { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+        else                { i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+    }
+    else{
+        if (y0 < z0)        { i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+        else if (x0 < z0)   { i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+        else                { i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+    }
+    float x1 = x0 - i1 + G3, y1 = y0 - j1 + G3, z1 = z0 - k1 + G3;
+    float x2 = x0 - i2 + 2 * G3, y2 = y0 - j2 + 2 * G3, z2 = z0 - k2 + 2 * G3;
+    float x3 = x0 - 1 + 3 * G3, y3 = y0 - 1 + 3 * G3, z3 = z0 - 1 + 3 * G3;
+    int ii = i & 255, jj = j & 255, kk = k & 255;
+
+    float n = 0;
+    float t0 = 0.6f - x0 * x0 - y0 * y0 - z0 * z0;
+    if (t0 > 0){ t0 *= t0; n += t0 * t0 * grad3(perm[ii + perm[jj + perm[kk]]], x0, y0, z0); }
+    float t1 = 0.6f - x1 * x1 - y1 * y1 - z1 * z1;
+    if (t1 > 0){ t1 *= t1; n += t1 * t1 * grad3(perm[ii + i1 + perm[jj + j1 + perm[kk + k1]]], x1, y1, z1); }
+    float t2 = 0.6f - x2 * x2 - y2 * y2 - z2 * z2;
+    if (t2 > 0){ t2 *= t2; n += t2 * t2 * grad3(perm[ii + i2 + perm[jj + j2 + perm[kk + k2]]], x2, y2, z2); }
+    float t3 = 0.6f - x3 * x3 - y3 * y3 - z3 * z3;
+    if (t3 > 0){ t3 *= t3; n += t3 * t3 * grad3(perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]], x3, y3, z3); }
+    return 32 * n;
+}
+
+//--------------------------------------------------------------
+// the same lookup ParticleSystem uses in place of ofSignedNoise(a, b, t)
+static inline float field_noise(const noiseField& noise, float a, float b, float t){
+    return noise.sample(a + t, b + 0.5f * t);
+}
+
+//--------------------------------------------------------------
+static void make_particles(benchParticles& p, int particles){
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> wx(0, BENCH_WIDTH), wy(0, BENCH_HEIGHT), u(-10000, 10000), d(0.95f, 0.998f);
+    p.x.resize(particles);
+    p.y.resize(particles);
+    p.vx.assign(particles, 0);
+    p.vy.assign(particles, 0);
+    p.drag.resize(particles);
+    p.uniqueVal.resize(particles);
+    for (int i=0; i<particles; i++){
+        p.x[i] = wx(rng);
+        p.y[i] = wy(rng);
+        p.drag[i] = d(rng);
+        p.uniqueVal[i] = u(rng);
+    }
+}
+
+//--------------------------------------------------------------
+// ParticleSystem's snow (PARTICLE_MODE_NOISE) forces, with either noise
+template <class Noise2, class Noise3>
+static void snow(benchParticles& p, float time, float height, Noise2 noise2, Noise3 noise3){
+    float wind_t = time * 0.6f;
+    float t = time * 0.2f;
+    int n = (int)p.x.size();
+    for (int i=0; i<n; i++){
+        float fakeWindX = noise3(p.x[i] * 0.003f, p.y[i] * 0.006f, wind_t);
+        float fx = fakeWindX * 0.25f + noise2(p.uniqueVal[i], p.y[i] * 0.04f) * 0.6f;
+        float fy = noise3(p.uniqueVal[i], p.x[i] * 0.006f, t) * 0.09f + 0.18f;
+        p.vx[i] = p.vx[i] * p.drag[i] + fx * 0.4f;
+        p.vy[i] = p.vy[i] * p.drag[i] + fy * 0.4f;
+        if (p.y[i] + p.vy[i] > height)
+            p.y[i] -= height;
+    }
+}
+
+//--------------------------------------------------------------
+// the drift away from the hand in the repel and nearest points modes
+template <class Noise3>
+static void wander(benchParticles& p, float time, Noise3 noise3){
+    float t = time * 0.2f;
+    int n = (int)p.x.size();
+    for (int i=0; i<n; i++){
+        p.vx[i] = p.vx[i] * p.drag[i] + noise3(p.uniqueVal[i], p.y[i] * 0.01f, t) * 0.04f;
+        p.vy[i] = p.vy[i] * p.drag[i] + noise3(p.uniqueVal[i], p.x[i] * 0.01f, t) * 0.04f;
+    }
+}
+
+//--------------------------------------------------------------
+static const char* MODE_NAMES[4] = {"attract", "repel", "nearest", "noise"};
+
+//--------------------------------------------------------------
+// scatters every particle, then times `iterations` updates in `mode`
+static int64_t time_system(ParticleSystem& system, const benchWorkload& hands, particleMode mode, int64_t iterations){
+    ParticleFrameContext context;
+    context.mode = mode;
+    context.target_x = BENCH_WIDTH / 2;
+    context.target_y = BENCH_HEIGHT / 2;
+    context.width = BENCH_WIDTH;
+    context.height = BENCH_HEIGHT;
+    context.attract_x = hands.ax.data();
+    context.attract_y = hands.ay.data();
+    context.num_attractors = (int)hands.ax.size();
+
+    system.setSeed(1);
+    system.reset(mode, BENCH_WIDTH, BENCH_HEIGHT);
+    for (int placed=0; placed<system.size(); placed+=PARTICLE_RESET_BATCH)
+        system.update(context);
+
+    int64_t start = now_ns();
+    for (int64_t i=0; i<iterations; i++){
+        context.time = i / 60.0f;
+        system.update(context);
+    }
+    keep(system.x[0]);
+    return now_ns() - start;
+}
+
+//--------------------------------------------------------------
+static std::vector<std::pair<std::string, benchFunction>> make_noise_cases(int particles){
+
+    std::vector<std::pair<std::string, benchFunction>> cases;
+    setup_simplex();
+    auto state = std::make_shared<benchParticles>();
+    make_particles(*state, particles);
+    auto field = std::make_shared<noiseField>();
+    field->setup();
+
+    auto simplex2 = [](float a, float b){ return simplex_noise(a, b); };
+    auto simplex3 = [](float a, float b, float c){ return simplex_noise(a, b, c); };
+    const noiseField* f = field.get();
+    auto field2 = [f](float a, float b){ return f->sample(a, b); };
+    auto field3 = [f](float a, float b, float c){ return field_noise(*f, a, b, c); };
+
+    // each pass moves time on a frame, so the lookups don't repeat
+    cases.emplace_back("snow/ofSignedNoise", [state, simplex2, simplex3](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            snow(*state, i / 60.0f, BENCH_HEIGHT, simplex2, simplex3);
+        keep(state->vx[0]);
+        return now_ns() - start;
+    });
+    cases.emplace_back("snow/noiseField", [state, field, field2, field3](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            snow(*state, i / 60.0f, BENCH_HEIGHT, field2, field3);
+        keep(state->vx[0]);
+        return now_ns() - start;
+    });
+    cases.emplace_back("wander/ofSignedNoise", [state, simplex3](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            wander(*state, i / 60.0f, simplex3);
+        keep(state->vx[0]);
+        return now_ns() - start;
+    });
+    cases.emplace_back("wander/noiseField", [state, field, field3](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            wander(*state, i / 60.0f, field3);
+        keep(state->vx[0]);
+        return now_ns() - start;
+    });
+
+    // the whole update, as ofApp runs it
+    auto system = std::make_shared<ParticleSystem>();
+    system->setup(particles);
+    auto hands = std::make_shared<benchWorkload>();
+    make_workload(*hands, 0, 42);
+    for (int m=PARTICLE_MODE_ATTRACT; m<=PARTICLE_MODE_NOISE; m++){
+        particleMode mode = (particleMode)m;
+        cases.emplace_back(std::string("system/") + MODE_NAMES[m], [system, hands, mode](int64_t iterations){
+            return time_system(*system, *hands, mode, iterations);
+        });
+    }
+    return cases;
+}
+
+//--------------------------------------------------------------
+// one case per thread count, all sharing one system of `particles`
+static std::vector<std::pair<std::string, benchFunction>> make_thread_cases(int particles, particleMode mode){
+
+    std::vector<std::pair<std::string, benchFunction>> cases;
+    auto system = std::make_shared<ParticleSystem>();
+    system->setup(particles);
+    auto hands = std::make_shared<benchWorkload>();
+    make_workload(*hands, 0, 42);
+    for (int threads : THREAD_COUNTS){
+        auto pool = std::make_shared<threadPool>();
+        pool->setup(threads);
+        cases.emplace_back(std::string("threads/") + MODE_NAMES[mode] + "/" + std::to_string(threads),
+                           [system, hands, mode, pool](int64_t iterations){
+            system->setThreadPool(pool.get());
+            int64_t spent = time_system(*system, *hands, mode, iterations);
+            system->setThreadPool(nullptr);
+            return spent;
+        });
+    }
+    return cases;
+}
+
+//--------------------------------------------------------------
+static void find_nearest_blocks(const benchWorkload& w, int* closest, float* dist_sq){
+    int n = (int)w.px.size();
+    for (int start=0; start<n; start+=NEAREST_BLOCK){
+        int count = std::min(NEAREST_BLOCK, n - start);
+        find_nearest_attractors(&w.px[start], &w.py[start], count, w.ax.data(), w.ay.data(), (int)w.ax.size(),
+                                closest + start, dist_sq + start);
+    }
+}
+
+//--------------------------------------------------------------
+static std::vector<std::pair<std::string, benchFunction>> make_nearest_cases(const benchWorkload& w){
+
+    static const char* KERNEL_NAMES[3] = {"scalar", "sse2", "avx2"};
+    std::vector<std::pair<std::string, benchFunction>> cases;
+    int n = (int)w.px.size();
+
+    // the plain loop's answer, to check the others against
+    std::vector<int> expected(n);
+    std::vector<float> expected_dist(n);
+    set_nearest_attractor_kernel(NEAREST_ATTRACTOR_SCALAR);
+    find_nearest_blocks(w, expected.data(), expected_dist.data());
+
+    for (int k=NEAREST_ATTRACTOR_SCALAR; k<=NEAREST_ATTRACTOR_AVX2; k++){
+        nearestAttractorKernel kernel = (nearestAttractorKernel)k;
+        set_nearest_attractor_kernel(kernel);
+        if (get_nearest_attractor_kernel() != kernel)
+            continue;
+
+        std::vector<int> closest(n);
+        std::vector<float> dist_sq(n);
+        find_nearest_blocks(w, closest.data(), dist_sq.data());
+        if (closest != expected)
+            fprintf(stderr, "nearest/%s disagrees with the plain loop on %s\n", KERNEL_NAMES[k], w.name.c_str());
+
+        cases.emplace_back(std::string("nearest/") + KERNEL_NAMES[k], [&w, kernel](int64_t iterations){
+            std::vector<int> closest(w.px.size());
+            std::vector<float> dist_sq(w.px.size());
+            set_nearest_attractor_kernel(kernel);
+            int64_t start = now_ns();
+            for (int64_t i=0; i<iterations; i++){
+                find_nearest_blocks(w, closest.data(), dist_sq.data());
+                keep(closest[0]);
+            }
+            return now_ns() - start;
+        });
+    }
+    return cases;
+}
+
+//--------------------------------------------------------------
+static benchResult measure(const benchFunction& fn, double min_time, int repetitions){
+
+    // grow the iteration count until one run takes a tenth of min_time,
+    // then scale it up to min_time
+    int64_t iterations = 1;
+    int64_t spent = 0;
+    while (true){
+        spent = std::max<int64_t>(1, fn(iterations));
+        if (spent >= min_time * 1e8 || iterations >= (1ll << 40))
+            break;
+        iterations *= spent < min_time * 1e7 ? 10 : 2;
+    }
+    iterations = std::max<int64_t>(1, (int64_t)(iterations * min_time * 1e9 / spent));
+
+    std::vector<double> per_op;
+    for (int r=0; r<repetitions; r++)
+        per_op.push_back(fn(iterations) / (double)iterations);
+    std::sort(per_op.begin(), per_op.end());
+
+    benchResult result;
+    result.ns_per_op = per_op[per_op.size() / 2];
+    result.min_ns_per_op = per_op[0];
+    return result;
+}
+
+//--------------------------------------------------------------
+static void write_json(FILE* out, int particles, double min_time, int repetitions, const std::vector<benchResult>& results){
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"particle_micro\",\n");
+    fprintf(out, "  \"version\": %d,\n", BENCH_VERSION);
+    fprintf(out, "  \"config\": {\"particles\": %d, \"min_time\": %g, \"repetitions\": %d},\n", particles, min_time, repetitions);
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i=0; i<results.size(); i++){
+        const benchResult& r = results[i];
+        std::string scaling = r.threads ? ", \"threads\": " + std::to_string(r.threads) + ", \"speedup\": " + std::to_string(r.speedup) : "";
+        fprintf(out, "    {\"name\": \"%s\", \"workload\": \"%s\", \"ns_per_op\": %.1f, \"min_ns_per_op\": %.1f, \"ns_per_particle\": %.3f%s}%s\n",
+                r.name.c_str(), r.workload.c_str(), r.ns_per_op, r.min_ns_per_op, r.ns_per_particle, scaling.c_str(), i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+//========================================================================
+int main(int argc, char** argv){
+
+    int particles = 100000;
+    std::string filter;
+    double min_time = 0.1;
+    int repetitions = 5;
+    std::string json_path;
+
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--particles" && has_value)          particles = std::max(1, atoi(argv[++i]));
+        else if (arg == "--filter" && has_value)        filter = argv[++i];
+        else if (arg == "--min-time" && has_value)      min_time = std::max(0.001, atof(argv[++i]));
+        else if (arg == "--repetitions" && has_value)   repetitions = std::max(1, atoi(argv[++i]));
+        else if (arg == "--json" && has_value)          json_path = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    // the nearest attractor search for one hand, and two; then the noise
+    // forces and whole updates, which don't depend on the hands
+    std::vector<benchWorkload> workloads(3);
+    make_workload(workloads[0], particles, 21);
+    make_workload(workloads[1], particles, 42);
+    workloads[2].name = "particles";
+
+    std::vector<benchResult> results;
+    printf("%-28s %-16s %14s %14s %10s\n", "case", "workload", "ns/op", "min ns/op", "ns/part");
+    for (benchWorkload& workload : workloads){
+        auto cases = workload.ax.empty() ? make_noise_cases(particles) : make_nearest_cases(workload);
+        for (auto& c : cases){
+            std::string full_name = c.first + "/" + workload.name;
+            if (!filter.empty() && full_name.find(filter) == std::string::npos)
+                continue;
+            benchResult result = measure(c.second, min_time, repetitions);
+            result.name = c.first;
+            result.workload = workload.name;
+            result.ns_per_particle = result.ns_per_op / particles;
+            printf("%-28s %-16s %14.0f %14.0f %10.3f\n", result.name.c_str(), result.workload.c_str(),
+                   result.ns_per_op, result.min_ns_per_op, result.ns_per_particle);
+            fflush(stdout);
+            results.push_back(result);
+        }
+    }
+
+    // how the whole update scales with threads
+    for (int count : THREAD_SWEEP_PARTICLES){
+        std::string workload = std::to_string(count) + "_particles";
+        for (particleMode mode : {PARTICLE_MODE_ATTRACT, PARTICLE_MODE_NEAREST_POINTS}){
+            double one_thread = 0;
+            auto cases = make_thread_cases(count, mode);
+            for (size_t t=0; t<cases.size(); t++){
+                std::string full_name = cases[t].first + "/" + workload;
+                if (!filter.empty() && full_name.find(filter) == std::string::npos)
+                    continue;
+                benchResult result = measure(cases[t].second, min_time, repetitions);
+                result.name = cases[t].first;
+                result.workload = workload;
+                result.ns_per_particle = result.ns_per_op / count;
+                result.threads = THREAD_COUNTS[t];
+                if (result.threads == 1)
+                    one_thread = result.ns_per_op;
+                result.speedup = one_thread > 0 ? one_thread / result.ns_per_op : 0;
+                printf("%-28s %-16s %14.0f %14.0f %10.3f  x%.2f\n", result.name.c_str(), result.workload.c_str(),
+                       result.ns_per_op, result.min_ns_per_op, result.ns_per_particle, result.speedup);
+                fflush(stdout);
+                results.push_back(result);
+            }
+        }
+    }
+    if (!json_path.empty()){
+        FILE* out = fopen(json_path.c_str(), "w");
+        if (!out){
+            perror(json_path.c_str());
+            return EXIT_FAILURE;
+        }
+        write_json(out, particles, min_time, repetitions, results);
+        fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
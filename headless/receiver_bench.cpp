@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "handFrame.h"
+#include "handMetrics.h"
+#include "landmarkFilter.h"
+#include "syntheticHand.h"
+
+/**
+ Micro-benchmarks for the per-frame work the receiver does after decoding.
+
+ filter/...: landmarkFilter::apply() on one hand (21 landmarks x 3 axes)
+ with One Euro and Kalman smoothing, fed a synthetic hand moving at 30 fps.
+ Each op copies the next frame in before filtering it; filter/none is that
+ copy alone, for a baseline.
+
+ metrics/...: recording one event into the handMetrics types the hot
+ paths use: metricCounter::add(), metricHistogram::record() with
+ durations spread over many buckets, and a metricTimer (two clock reads
+ and a record).
+
+ Same harness as wrapper_bench: each case is calibrated to run for
+ --min-time, then repeated and the median kept.
+
+ Usage: hand_receiver_bench [options]
+   --filter TEXT         only run cases whose name contains TEXT
+   --min-time SECS       time per repetition (default 0.1)
+   --repetitions N       repetitions per case, the median is reported (default 5)
+   --json FILE           also write the results as JSON to FILE
+ */
+
+#define BENCH_VERSION 1
+
+// frames of motion the filter cases cycle through
+#define BENCH_FRAMES 256
+#define BENCH_FRAME_USEC 33333
+
+// runs the operation `iterations` times and returns the nanoseconds spent
+typedef std::function<int64_t(int64_t iterations)> benchFunction;
+
+struct benchResult{
+    std::string name;
+    double ns_per_op = 0;
+    double min_ns_per_op = 0;
+};
+
+//--------------------------------------------------------------
+static inline int64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+// stops the compiler from optimizing away a result
+template <class T>
+static inline void keep(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--filter TEXT] [--min-time SECS] [--repetitions N] [--json FILE]\n", name);
+}
+
+//--------------------------------------------------------------
+static std::vector<std::pair<std::string, benchFunction>> make_filter_cases(){
+
+    static const char* MODE_NAMES[3] = {"none", "one_euro", "kalman"};
+    std::vector<std::pair<std::string, benchFunction>> cases;
+
+    auto frames = std::make_shared<std::vector<HandFrame>>(BENCH_FRAMES);
+    syntheticHand hand(1);
+    for (int i=0; i<BENCH_FRAMES; i++)
+        hand.pose(i * BENCH_FRAME_USEC / 1000000.0, (*frames)[i]);
+
+    for (int m=LANDMARK_FILTER_NONE; m<=LANDMARK_FILTER_KALMAN; m++){
+        landmarkFilterMode mode = (landmarkFilterMode)m;
+        auto filter = std::make_shared<landmarkFilter>();
+        filter->setMode(mode);
+
+        // the clock runs on across calls, so the filter never sees a late frame
+        auto timestamp = std::make_shared<int64_t>(0);
+        cases.emplace_back(std::string("filter/") + MODE_NAMES[m], [frames, filter, timestamp](int64_t iterations){
+            HandFrame frame;
+            int64_t start = now_ns();
+            for (int64_t i=0; i<iterations; i++){
+                frame = (*frames)[i % BENCH_FRAMES];
+                frame.timestamp_usec = (*timestamp += BENCH_FRAME_USEC);
+                filter->apply(frame);
+                keep(frame.x[0]);
+            }
+            return now_ns() - start;
+        });
+    }
+    return cases;
+}
+
+//--------------------------------------------------------------
+static std::vector<std::pair<std::string, benchFunction>> make_metric_cases(){
+
+    std::vector<std::pair<std::string, benchFunction>> cases;
+
+    // durations from tens of nanoseconds to tens of milliseconds
+    auto durations = std::make_shared<std::vector<uint64_t>>(BENCH_FRAMES);
+    for (int i=0; i<BENCH_FRAMES; i++)
+        (*durations)[i] = 20ull << (i % 20);
+
+    auto counter = std::make_shared<metricCounter>();
+    cases.emplace_back("metrics/counter_add", [counter](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            counter->add();
+        keep(counter->get());
+        return now_ns() - start;
+    });
+    auto histogram = std::make_shared<metricHistogram>();
+    cases.emplace_back("metrics/histogram_record", [histogram, durations](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            histogram->record((*durations)[i % BENCH_FRAMES]);
+        keep(histogram->getSum());
+        return now_ns() - start;
+    });
+    cases.emplace_back("metrics/timer", [histogram](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++){
+            metricTimer timer(*histogram);
+        }
+        keep(histogram->getSum());
+        return now_ns() - start;
+    });
+    return cases;
+}
+
+//--------------------------------------------------------------
+static benchResult measure(const benchFunction& fn, double min_time, int repetitions){
+
+    // grow the iteration count until one run takes a tenth of min_time,
+    // then scale it up to min_time
+    int64_t iterations = 1;
+    int64_t spent = 0;
+    while (true){
+        spent = std::max<int64_t>(1, fn(iterations));
+        if (spent >= min_time * 1e8 || iterations >= (1ll << 40))
+            break;
+        iterations *= spent < min_time * 1e7 ? 10 : 2;
+    }
+    iterations = std::max<int64_t>(1, (int64_t)(iterations * min_time * 1e9 / spent));
+
+    std::vector<double> per_op;
+    for (int r=0; r<repetitions; r++)
+        per_op.push_back(fn(iterations) / (double)iterations);
+    std::sort(per_op.begin(), per_op.end());
+
+    benchResult result;
+    result.ns_per_op = per_op[per_op.size() / 2];
+    result.min_ns_per_op = per_op[0];
+    return result;
+}
+
+//--------------------------------------------------------------
+static void write_json(FILE* out, double min_time, int repetitions, const std::vector<benchResult>& results){
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"receiver_micro\",\n");
+    fprintf(out, "  \"version\": %d,\n", BENCH_VERSION);
+    fprintf(out, "  \"config\": {\"min_time\": %g, \"repetitions\": %d},\n", min_time, repetitions);
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i=0; i<results.size(); i++){
+        const benchResult& r = results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"ns_per_op\": %.1f, \"min_ns_per_op\": %.1f}%s\n",
+                r.name.c_str(), r.ns_per_op, r.min_ns_per_op, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+//========================================================================
+int main(int argc, char** argv){
+
+    std::string filter;
+    double min_time = 0.1;
+    int repetitions = 5;
+    std::string json_path;
+
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)             filter = argv[++i];
+        else if (arg == "--min-time" && has_value)      min_time = std::max(0.001, atof(argv[++i]));
+        else if (arg == "--repetitions" && has_value)   repetitions = std::max(1, atoi(argv[++i]));
+        else if (arg == "--json" && has_value)          json_path = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    std::vector<benchResult> results;
+    printf("%-28s %12s %12s\n", "case", "ns/op", "min ns/op");
+    auto cases = make_filter_cases();
+    for (auto& c : make_metric_cases())
+        cases.push_back(c);
+    for (auto& c : cases){
+        if (!filter.empty() && c.first.find(filter) == std::string::npos)
+            continue;
+        benchResult result = measure(c.second, min_time, repetitions);
+        result.name = c.first;
+        printf("%-28s %12.1f %12.1f\n", result.name.c_str(), result.ns_per_op, result.min_ns_per_op);
+        fflush(stdout);
+        results.push_back(result);
+    }
+    if (!json_path.empty()){
+        FILE* out = fopen(json_path.c_str(), "w");
+        if (!out){
+            perror(json_path.c_str());
+            return EXIT_FAILURE;
+        }
+        write_json(out, min_time, repetitions, results);
+        fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
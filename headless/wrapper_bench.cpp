@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include "wrapper_hand_tracking.pb.h"
+#include "handFrame.h"
+#include "syntheticHand.h"
+
+/**
+ Micro-benchmarks for the generated WrapperHandTracking message.
+
+ Times what a sender and a receiver do with the message, per operation:
+ building it the way MyPassThroughCalculator does (fresh, or by clearing
+ and refilling one message), Clear, ByteSizeLong, the three ways to
+ serialize (SerializeToString, SerializeToArray, a CodedOutputStream over
+ an array) and ParseFromArray into a heap message (reused or fresh) or an
+ arena one. Each runs on payloads of 1, 2 and 4 hands (21 landmarks each,
+ in one landmark list) with and without a palm detection per hand, so a
+ change to the proto, the protobuf version or the generator shows up here.
+
+ A small harness of our own rather than Google Benchmark, so it builds
+ with just protobuf: each case is calibrated to run for --min-time, then
+ repeated and the median kept.
+
+ Usage: hand_wrapper_bench [options]
+   --filter TEXT         only run cases whose name contains TEXT
+   --min-time SECS       time per repetition (default 0.1)
+   --repetitions N       repetitions per case, the median is reported (default 5)
+   --json FILE           also write the results as JSON to FILE
+ */
+
+#define BENCH_VERSION 1
+
+// the clear benchmark works on this many filled messages at a time
+#define CLEAR_BATCH 64
+
+typedef ::mediapipe::WrapperHandTracking Wrapper;
+
+// runs the operation `iterations` times and returns the nanoseconds spent
+// on it (cases that need untimed setup between operations time themselves)
+typedef std::function<int64_t(int64_t iterations)> benchFunction;
+
+struct benchPayload{
+    std::string name;
+    int hands = 1;
+    std::vector<HandFrame> frames;
+    std::vector<::mediapipe::Detection> detections;
+    Wrapper filled;
+    std::string serialized;
+};
+
+struct benchResult{
+    std::string name;
+    std::string payload;
+    int bytes = 0;
+    double ns_per_op = 0;
+    double min_ns_per_op = 0;
+};
+
+//--------------------------------------------------------------
+static inline int64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+// stops the compiler from optimizing away a result
+template <class T>
+static inline void keep(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//--------------------------------------------------------------
+static void usage(const char* name){
+    fprintf(stderr, "usage: %s [--filter TEXT] [--min-time SECS] [--repetitions N] [--json FILE]\n", name);
+}
+
+//--------------------------------------------------------------
+// what MyPassThroughCalculator::Process() puts in the wrapper for one frame
+static void fill_wrapper(Wrapper& wrapper, const benchPayload& payload){
+    wrapper.set_timestamp_usec(1234567);
+    for (const HandFrame& frame : payload.frames){
+        for (int i=0; i<frame.num_landmarks; i++){
+            ::mediapipe::NormalizedLandmark* out = wrapper.mutable_landmarks()->add_landmark();
+            out->set_x(frame.x[i]);
+            out->set_y(frame.y[i]);
+            out->set_z(frame.z[i]);
+        }
+    }
+    for (const ::mediapipe::Detection& detection : payload.detections)
+        wrapper.mutable_detection()->add_detection()->CopyFrom(detection);
+    const HandFrame& frame = payload.frames[0];
+    wrapper.mutable_rect()->set_x_center(frame.rect_x_center);
+    wrapper.mutable_rect()->set_y_center(frame.rect_y_center);
+    wrapper.mutable_rect()->set_width(frame.rect_width);
+    wrapper.mutable_rect()->set_height(frame.rect_height);
+    wrapper.mutable_rect()->set_rotation(frame.rect_rotation);
+    wrapper.set_sequence_id(4242);
+    wrapper.set_send_time_usec(1700000000000000);
+}
+
+//--------------------------------------------------------------
+// a palm detection as the hand tracking graph emits it: score, relative
+// bounding box and seven keypoints
+static ::mediapipe::Detection palm_detection(const HandFrame& frame){
+    ::mediapipe::Detection detection;
+    detection.add_label_id(0);
+    detection.add_score(0.97f);
+    ::mediapipe::LocationData* location = detection.mutable_location_data();
+    location->set_format(::mediapipe::LocationData::RELATIVE_BOUNDING_BOX);
+    ::mediapipe::LocationData_RelativeBoundingBox* box = location->mutable_relative_bounding_box();
+    box->set_xmin(frame.rect_x_center - frame.rect_width / 2);
+    box->set_ymin(frame.rect_y_center - frame.rect_height / 2);
+    box->set_width(frame.rect_width);
+    box->set_height(frame.rect_height);
+    static const int KEYPOINTS[7] = {0, 5, 9, 13, 17, 1, 2};
+    for (int k : KEYPOINTS){
+        ::mediapipe::LocationData_RelativeKeypoint* keypoint = location->add_relative_keypoints();
+        keypoint->set_x(frame.x[k]);
+        keypoint->set_y(frame.y[k]);
+    }
+    return detection;
+}
+
+//--------------------------------------------------------------
+static void make_payload(benchPayload& payload, int hands, bool detections){
+    payload.hands = hands;
+    payload.name = std::to_string(hands) + (hands == 1 ? "_hand" : "_hands") + (detections ? "_detections" : "");
+    payload.frames.resize(hands);
+    for (int i=0; i<hands; i++){
+        syntheticHand hand(i + 1);
+        hand.pose(0.5, payload.frames[i]);
+        if (detections)
+            payload.detections.push_back(palm_detection(payload.frames[i]));
+    }
+    fill_wrapper(payload.filled, payload);
+    payload.filled.SerializeToString(&payload.serialized);
+}
+
+//--------------------------------------------------------------
+// the whole loop is timed
+template <class F>
+static benchFunction timed(F fn){
+    return [fn](int64_t iterations){
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++)
+            fn();
+        return now_ns() - start;
+    };
+}
+
+//--------------------------------------------------------------
+static std::vector<std::pair<std::string, benchFunction>> make_cases(benchPayload& p){
+
+    std::vector<std::pair<std::string, benchFunction>> cases;
+    const char* data = p.serialized.data();
+    int size = p.serialized.size();
+
+    // sender side
+    cases.emplace_back("construct", timed([]{
+        Wrapper wrapper;
+        keep(wrapper);
+    }));
+    cases.emplace_back("build_fresh", timed([&p]{
+        Wrapper wrapper;
+        fill_wrapper(wrapper, p);
+        keep(wrapper);
+    }));
+    auto reused = std::make_shared<Wrapper>();
+    cases.emplace_back("build_reused", timed([&p, reused]{
+        reused->Clear();
+        fill_wrapper(*reused, p);
+        keep(*reused);
+    }));
+    cases.emplace_back("clear", [&p](int64_t iterations){
+        // Clear() on an empty message is nearly free, so refill a batch
+        // between the timed clears
+        std::vector<Wrapper> batch(CLEAR_BATCH);
+        int64_t spent = 0;
+        for (int64_t done=0; done<iterations; done+=CLEAR_BATCH){
+            for (Wrapper& wrapper : batch)
+                wrapper.CopyFrom(p.filled);
+            int n = std::min<int64_t>(CLEAR_BATCH, iterations - done);
+            int64_t start = now_ns();
+            for (int i=0; i<n; i++)
+                batch[i].Clear();
+            spent += now_ns() - start;
+        }
+        return spent;
+    });
+    cases.emplace_back("byte_size", timed([&p]{
+        keep(p.filled.ByteSizeLong());
+    }));
+    cases.emplace_back("serialize_to_string", timed([&p]{
+        std::string buffer;
+        p.filled.SerializeToString(&buffer);
+        keep(buffer);
+    }));
+    auto string_buffer = std::make_shared<std::string>();
+    cases.emplace_back("serialize_to_string_reused", timed([&p, string_buffer]{
+        p.filled.SerializeToString(string_buffer.get());
+        keep(*string_buffer);
+    }));
+    auto array = std::make_shared<std::vector<char>>(4096);
+    cases.emplace_back("serialize_to_array", timed([&p, array]{
+        int n = p.filled.ByteSizeLong();
+        p.filled.SerializeToArray(array->data(), n);
+        keep(*array);
+    }));
+    cases.emplace_back("serialize_coded_stream", timed([&p, array]{
+        int n = p.filled.ByteSizeLong();
+        ::google::protobuf::io::ArrayOutputStream stream(array->data(), n);
+        ::google::protobuf::io::CodedOutputStream coded(&stream);
+        p.filled.SerializeWithCachedSizes(&coded);
+        keep(*array);
+    }));
+
+    // receiver side
+    auto parsed = std::make_shared<Wrapper>();
+    cases.emplace_back("parse_heap_reused", timed([parsed, data, size]{
+        parsed->ParseFromArray(data, size);
+        keep(*parsed);
+    }));
+    cases.emplace_back("parse_heap_fresh", timed([data, size]{
+        Wrapper wrapper;
+        wrapper.ParseFromArray(data, size);
+        keep(wrapper);
+    }));
+    // the proto doesn't set cc_enable_arenas, so only the top-level message
+    // lives on the arena; its submessages still come from the heap
+    cases.emplace_back("parse_arena", timed([data, size]{
+        ::google::protobuf::Arena arena;
+        Wrapper* wrapper = ::google::protobuf::Arena::Create<Wrapper>(&arena);
+        wrapper->ParseFromArray(data, size);
+        keep(*wrapper);
+    }));
+    auto block = std::make_shared<std::vector<char>>(16384);
+    cases.emplace_back("parse_arena_reused", [data, size, block](int64_t iterations){
+        ::google::protobuf::ArenaOptions options;
+        options.initial_block = block->data();
+        options.initial_block_size = block->size();
+        ::google::protobuf::Arena arena(options);
+        int64_t start = now_ns();
+        for (int64_t i=0; i<iterations; i++){
+            Wrapper* wrapper = ::google::protobuf::Arena::Create<Wrapper>(&arena);
+            wrapper->ParseFromArray(data, size);
+            keep(*wrapper);
+            arena.Reset();
+        }
+        return now_ns() - start;
+    });
+    return cases;
+}
+
+//--------------------------------------------------------------
+static benchResult measure(const benchFunction& fn, double min_time, int repetitions){
+
+    // grow the iteration count until one run takes a tenth of min_time,
+    // then scale it up to min_time
+    int64_t iterations = 1;
+    int64_t spent = 0;
+    while (true){
+        spent = std::max<int64_t>(1, fn(iterations));
+        if (spent >= min_time * 1e8 || iterations >= (1ll << 40))
+            break;
+        iterations *= spent < min_time * 1e7 ? 10 : 2;
+    }
+    iterations = std::max<int64_t>(1, (int64_t)(iterations * min_time * 1e9 / spent));
+
+    std::vector<double> per_op;
+    for (int r=0; r<repetitions; r++)
+        per_op.push_back(fn(iterations) / (double)iterations);
+    std::sort(per_op.begin(), per_op.end());
+
+    benchResult result;
+    result.ns_per_op = per_op[per_op.size() / 2];
+    result.min_ns_per_op = per_op[0];
+    return result;
+}
+
+//--------------------------------------------------------------
+static void write_json(FILE* out, double min_time, int repetitions, const std::vector<benchResult>& results){
+    fprintf(out, "{\n");
+    fprintf(out, "  \"bench\": \"wrapper_micro\",\n");
+    fprintf(out, "  \"version\": %d,\n", BENCH_VERSION);
+    fprintf(out, "  \"protobuf\": \"%s\",\n", ::google::protobuf::internal::VersionString(GOOGLE_PROTOBUF_VERSION).c_str());
+    fprintf(out, "  \"config\": {\"min_time\": %g, \"repetitions\": %d},\n", min_time, repetitions);
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i=0; i<results.size(); i++){
+        const benchResult& r = results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"payload\": \"%s\", \"bytes\": %d, \"ns_per_op\": %.1f, \"min_ns_per_op\": %.1f}%s\n",
+                r.name.c_str(), r.payload.c_str(), r.bytes, r.ns_per_op, r.min_ns_per_op, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+//========================================================================
+int main(int argc, char** argv){
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    std::string filter;
+    double min_time = 0.1;
+    int repetitions = 5;
+    std::string json_path;
+
+    for (int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)             filter = argv[++i];
+        else if (arg == "--min-time" && has_value)      min_time = std::max(0.001, atof(argv[++i]));
+        else if (arg == "--repetitions" && has_value)   repetitions = std::max(1, atoi(argv[++i]));
+        else if (arg == "--json" && has_value)          json_path = argv[++i];
+        else { usage(argv[0]); return EXIT_FAILURE; }
+    }
+
+    std::vector<benchPayload> payloads(6);
+    int hand_counts[3] = {1, 2, 4};
+    for (int i=0; i<6; i++)
+        make_payload(payloads[i], hand_counts[i % 3], i >= 3);
+
+    std::vector<benchResult> results;
+    printf("%-28s %-20s %6s %12s %12s\n", "case", "payload", "bytes", "ns/op", "min ns/op");
+    for (benchPayload& payload : payloads){
+        for (auto& c : make_cases(payload)){
+            std::string full_name = c.first + "/" + payload.name;
+            if (!filter.empty() && full_name.find(filter) == std::string::npos)
+                continue;
+            benchResult result = measure(c.second, min_time, repetitions);
+            result.name = c.first;
+            result.payload = payload.name;
+            result.bytes = payload.serialized.size();
+            printf("%-28s %-20s %6d %12.1f %12.1f\n", result.name.c_str(), result.payload.c_str(),
+                   result.bytes, result.ns_per_op, result.min_ns_per_op);
+            fflush(stdout);
+            results.push_back(result);
+        }
+    }
+
+    if (!json_path.empty()){
+        FILE* out = fopen(json_path.c_str(), "w");
+        if (!out){
+            perror(json_path.c_str());
+            return EXIT_FAILURE;
+        }
+        write_json(out, min_time, repetitions, results);
+        fclose(out);
+    }
+
+    google::protobuf::ShutdownProtobufLibrary();
+    return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include "mediapipe/framework/formats/wrapper_hand_tracking.pb.h"
 
 
+#include <chrono>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -31,6 +32,34 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 
+// Span tracing (Process, serialize, sendto) for lining up against the
+// receiver's trace. Off unless built with --copt=-DHAND_TRACE and
+// handTrace.h/.cc copied next to this file (see the README).
+#ifdef HAND_TRACE
+#include "mediapipe/calculators/core/handTrace.h"
+#else
+#define HAND_TRACE_SCOPE(name)
+#endif
+
+// Prometheus metrics (frames and bytes sent, send failures, Process /
+// serialize / sendto times), exported to $HAND_METRICS_FILE or served on
+// $HAND_METRICS_SOCKET. Off unless built with --copt=-DHAND_METRICS and
+// handMetrics.h/.cc copied next to this file (see the README).
+#ifdef HAND_METRICS
+#include "mediapipe/calculators/core/handMetrics.h"
+#define HAND_METRICS_TIMER(histogram) metricTimer histogram##_timer(metrics.histogram)
+#else
+#define HAND_METRICS_TIMER(histogram)
+#endif
+
+// Backpressure: read the receiver's feedback datagrams off the socket and,
+// while it falls behind, skip frames to its pace and leave out z. Off
+// unless built with --copt=-DHAND_BACKPRESSURE and handBackpressure.h/.cc
+// copied next to this file (see the README).
+#ifdef HAND_BACKPRESSURE
+#include "mediapipe/calculators/core/handBackpressure.h"
+#endif
+
 #define PORT     8080
 #define MAXLINE 1024
 int sockfd;
@@ -43,6 +72,33 @@ constexpr char kNormLandmarksTag[] = "NORM_LANDMARKS"; // MAD note @to-fix: stre
 constexpr char kNormRectTag[] = "NORM_RECT";
 constexpr char kDetectionsTag[] = "DETECTIONS";
 
+#ifdef HAND_METRICS
+struct senderMetrics{
+  metricCounter frames_sent;
+  metricCounter bytes_sent;
+  metricCounter send_failures;
+  metricHistogram process;
+  metricHistogram serialize;
+  metricHistogram send;
+  handMetrics registry;   // last, so it stops exporting before the rest go
+
+  void setup(){
+    registry.add(&frames_sent, "hand_sender_frames", "Datagrams sent");
+    registry.add(&bytes_sent, "hand_sender_bytes", "Bytes sent");
+    registry.add(&send_failures, "hand_sender_send_failures", "Datagrams sendto() refused");
+    registry.add(&process, "hand_sender_stage", "Time per calculator stage, per frame", "stage=\"process\"");
+    registry.add(&serialize, "hand_sender_stage", "Time per calculator stage, per frame", "stage=\"serialize\"");
+    registry.add(&send, "hand_sender_stage", "Time per calculator stage, per frame", "stage=\"sendto\"");
+    const char* file = getenv("HAND_METRICS_FILE");
+    const char* socket_path = getenv("HAND_METRICS_SOCKET");
+    if ((file && !registry.serveFile(file)) || (socket_path && !registry.serveSocket(socket_path)))
+      LOG(ERROR) << "hand metrics: " << registry.getError();
+    else if (!file && !socket_path)
+      registry.serveFile("hand_metrics_sender.prom");
+  }
+};
+#endif
+
 
 void setup_udp(){
   // int sockfd;
@@ -131,6 +187,12 @@ class MyPassThroughCalculator : public CalculatorBase {
     }
     cc->SetOffset(TimestampDiff(0));
 
+#ifdef HAND_TRACE
+    handTrace::setProcessName("sender (MediaPipe)");
+#endif
+#ifdef HAND_METRICS
+    metrics.setup();
+#endif
 
     setup_udp();
 
@@ -139,37 +201,55 @@ class MyPassThroughCalculator : public CalculatorBase {
   }
 
   ::mediapipe::Status Process(CalculatorContext* cc) final {
+    HAND_TRACE_SCOPE("Process");
+    HAND_METRICS_TIMER(process);
     cc->GetCounter("PassThrough")->Increment();
     if (cc->Inputs().NumEntries() == 0) {
       return tool::StatusStop();
     }
+    /*-------------------------------------------------------------------*/
+    /*------------ EDITS to original pass_through_calculator ------------*/
+    /*-------------------------------------------------------------------*/
+
+    bool send_frame = true;
+    bool lean = false;
+#ifdef HAND_BACKPRESSURE
+    {
+      int64 now = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+      char feedback[256];
+      ssize_t n;
+      while ((n = recv(sockfd, feedback, sizeof(feedback), MSG_DONTWAIT)) > 0)
+        backpressure.onFeedback(feedback, n, now);
+      send_frame = backpressure.shouldSend(now);
+      lean = backpressure.useLeanEncoding();
+    }
+#endif
+
+    // All inputs of one Process() call share a timestamp, so bundle them
+    // into a single wrapper and send one datagram per frame. The receiver
+    // re-times frames using timestamp_usec.
+    WrapperHandTracking wrapper;
+    wrapper.set_timestamp_usec(cc->InputTimestamp().Microseconds());
+
     for (CollectionItemId id = cc->Inputs().BeginId();
          id < cc->Inputs().EndId(); ++id) {
       if (!cc->Inputs().Get(id).IsEmpty()) {
 
-
-        /*-------------------------------------------------------------------*/
-        /*------------ EDITS to original pass_through_calculator ------------*/
-        /*-------------------------------------------------------------------*/
-
-        WrapperHandTracking* wrapper = new WrapperHandTracking();
-        wrapper->InitAsDefaultInstance();
-
         if (cc->Inputs().Get(id).Name() == "hand_landmarks"){
           // the type is a NormalizedLandmarkList, but you need the kLandmarksTag
           // in order for it not to crash for some reason ...
           const NormalizedLandmarkList& landmarks = cc->Inputs().Tag(kLandmarksTag).Get<NormalizedLandmarkList>();
 
-
           for (int i = 0; i < landmarks.landmark_size(); ++i) {
               const NormalizedLandmark& landmark = landmarks.landmark(i);
               // std::cout << "Landmark " << i <<":\n" << landmark.DebugString() << '\n';
 
-              wrapper->mutable_landmarks()->add_landmark();
-              int size = wrapper->mutable_landmarks()->landmark_size()-1;
-              wrapper->mutable_landmarks()->mutable_landmark(size)->set_x(landmark.x());
-              wrapper->mutable_landmarks()->mutable_landmark(size)->set_y(landmark.y());
-              wrapper->mutable_landmarks()->mutable_landmark(size)->set_z(landmark.z());
+              NormalizedLandmark* out = wrapper.mutable_landmarks()->add_landmark();
+              out->set_x(landmark.x());
+              out->set_y(landmark.y());
+              if (!lean)
+                out->set_z(landmark.z());
           }
         }
 
@@ -179,7 +259,7 @@ class MyPassThroughCalculator : public CalculatorBase {
           for (int i = 0; i < detections.size(); ++i) {
               const Detection& detection = detections[i];
               // std::cout << "\n----- Detection -----\n " << detection.DebugString() << '\n';
-              // wrapper->mutable_detection()->add_detection();
+              // wrapper.mutable_detection()->add_detection();
 
           }
         }
@@ -188,53 +268,70 @@ class MyPassThroughCalculator : public CalculatorBase {
           // The Hand Rect is an x,y center, width, height, and angle (in radians)
           const NormalizedRect& rect = cc->Inputs().Tag(kNormRectTag).Get<NormalizedRect>();
 
-          wrapper->mutable_rect()->set_x_center(rect.x_center());
-          wrapper->mutable_rect()->set_y_center(rect.y_center());
-          wrapper->mutable_rect()->set_width(rect.width());
-          wrapper->mutable_rect()->set_height(rect.height());
-          wrapper->mutable_rect()->set_rotation(rect.rotation());
-
+          wrapper.mutable_rect()->set_x_center(rect.x_center());
+          wrapper.mutable_rect()->set_y_center(rect.y_center());
+          wrapper.mutable_rect()->set_width(rect.width());
+          wrapper.mutable_rect()->set_height(rect.height());
+          wrapper.mutable_rect()->set_rotation(rect.rotation());
 
           // std::cout << "Hand Rect: " << rect.DebugString() << '\n';
-          std::string msg_buffer;
-          rect.SerializeToString(&msg_buffer);
-          sendto(sockfd, msg_buffer.c_str(), msg_buffer.length(),
-              0, (const struct sockaddr *) &servaddr,
-                  sizeof(servaddr));
-
-        }
-
-        // std::cout << "  Passing " << cc->Inputs().Get(id).Name() << " to "
-                // << cc->Outputs().Get(id).Name() << " at "
-                // << cc->InputTimestamp().DebugString() << std::endl;
-
-        // nothing gets to here
-        if (cc->Inputs().HasTag(kNormLandmarksTag)) {
-          // std::cout << "kNormLandmarksTag" << std::endl << std::endl;
-          // std::cout << "  Passing " << cc->Inputs().Get(id).Name() << " to "
-                  // << cc->Outputs().Get(id).Name() << " at "
-                  // << cc->InputTimestamp().DebugString() << std::endl;
         }
 
-        std::string msg_buffer;
-        wrapper->SerializeToString(&msg_buffer);
-
-        sendto(sockfd, msg_buffer.c_str(), msg_buffer.length(),
-            0, (const struct sockaddr *) &servaddr,
-                sizeof(servaddr));
-
-      /*-------------------------------------------------------------------*/
-
         VLOG(3) << "Passing " << cc->Inputs().Get(id).Name() << " to "
                 << cc->Outputs().Get(id).Name() << " at "
                 << cc->InputTimestamp().DebugString();
         cc->Outputs().Get(id).AddPacket(cc->Inputs().Get(id).Value());
       }
     }
+
+    // a skipped frame still passes through, it just isn't sent (and takes
+    // no sequence id, so the receiver doesn't count it as lost)
+    if (!send_frame) {
+      return ::mediapipe::OkStatus();
+    }
+
+    // stamp right before sending so receivers can measure loss and latency
+    wrapper.set_sequence_id(sequence_id++);
+    wrapper.set_send_time_usec(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    std::string msg_buffer;
+    {
+      HAND_TRACE_SCOPE("serialize");
+      HAND_METRICS_TIMER(serialize);
+      wrapper.SerializeToString(&msg_buffer);
+    }
+
+    {
+      HAND_TRACE_SCOPE("sendto");
+      HAND_METRICS_TIMER(send);
+      ssize_t sent = sendto(sockfd, msg_buffer.c_str(), msg_buffer.length(),
+          0, (const struct sockaddr *) &servaddr,
+              sizeof(servaddr));
+#ifdef HAND_METRICS
+      if (sent < 0) {
+        metrics.send_failures.add();
+      } else {
+        metrics.frames_sent.add();
+        metrics.bytes_sent.add(sent);
+      }
+#endif
+      (void)sent;
+    }
+
+    /*-------------------------------------------------------------------*/
+
     return ::mediapipe::OkStatus();
   }
 
   ::mediapipe::Status Close(CalculatorContext* cc) {
+#ifdef HAND_TRACE
+    const char* trace_path = getenv("HAND_TRACE_FILE");
+    handTrace::write(trace_path ? trace_path : "hand_trace_sender.json");
+#endif
+#ifdef HAND_METRICS
+    metrics.registry.stop();
+#endif
     if (!cc->GraphStatus().ok()) {
       return ::mediapipe::OkStatus();
     }
@@ -242,6 +339,15 @@ class MyPassThroughCalculator : public CalculatorBase {
     return ::mediapipe::OkStatus();
   }
 
+ private:
+  // sequence number of the next outgoing message
+  uint64_t sequence_id = 0;
+#ifdef HAND_METRICS
+  senderMetrics metrics;
+#endif
+#ifdef HAND_BACKPRESSURE
+  handBackpressure backpressure;
+#endif
 };
 REGISTER_CALCULATOR(MyPassThroughCalculator);
 
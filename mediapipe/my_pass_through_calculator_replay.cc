@@ -0,0 +1,352 @@
+// Copyright 2019 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Offline replay harness for MyPassThroughCalculator.
+//
+// Feeds hand landmarks, hand rects and palm detections into the calculator
+// through CalculatorRunner at fixed timestamps, with no camera and no model,
+// so encode-path changes can be measured on their own. The packets come from
+// a capture file recorded by the receivers (--record, or 'c' in the
+// openFrameworks app) or, without one, from a deterministic synthetic hand.
+//
+// Each repetition runs the whole stream through MyPassThroughCalculator and
+// through the stock PassThroughCalculator with the same streams. The
+// difference per packet is what the exporter (building, serializing and
+// sending the wrapper) costs on top of the graph's own scheduling. The
+// datagrams the calculator sends to PORT are caught by a local socket and
+// counted, so nothing else may be listening on that port.
+//
+//   bazel run -c opt //mediapipe/calculators/core:my_pass_through_calculator_replay --
+//       [--capture FILE] [--frames N] [--fps N] [--detections-every N] [--repetitions N]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/util/delimited_message_util.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/wrapper_hand_tracking.pb.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+
+// must match the calculator
+#define PORT 8080
+
+namespace mediapipe {
+namespace {
+
+// the calculator picks its inputs by stream name, so these are the names
+// from the hand tracking graph (see the README)
+constexpr char kNodeTemplate[] = R"(
+  calculator: "%s"
+  input_stream: "LANDMARKS:hand_landmarks"
+  input_stream: "NORM_RECT:hand_rect"
+  input_stream: "DETECTIONS:palm_detections"
+  output_stream: "LANDMARKS:hand_landmarks_out"
+  output_stream: "NORM_RECT:hand_rect_out"
+  output_stream: "DETECTIONS:palm_detections_out"
+)";
+
+// one graph timestamp; a stream without a value there gets no packet
+struct ReplayFrame {
+  int64 timestamp_usec;
+  bool has_landmarks = false;
+  NormalizedLandmarkList landmarks;
+  bool has_rect = false;
+  NormalizedRect rect;
+  bool has_detections = false;
+  std::vector<Detection> detections;
+};
+
+// Reads a capture file (plain or gzipped, as the receivers write them; an
+// indexed capture isn't supported). Timestamps are the sender's, nudged
+// forward where needed, since a graph stream's must strictly increase.
+bool LoadCapture(const std::string& path, std::vector<ReplayFrame>* frames) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "can't open %s\n", path.c_str());
+    return false;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const std::string data = contents.str();
+
+  google::protobuf::io::ArrayInputStream array(data.data(), data.size());
+  google::protobuf::io::GzipInputStream gzip(&array, google::protobuf::io::GzipInputStream::GZIP);
+  bool is_gzip = data.size() >= 2 && (uint8)data[0] == 0x1f && (uint8)data[1] == 0x8b;
+  google::protobuf::io::ZeroCopyInputStream* stream = is_gzip ? (google::protobuf::io::ZeroCopyInputStream*)&gzip : &array;
+
+  HandTrackingCaptureRecord record;
+  bool clean_eof = false;
+  int64 last_timestamp = -1;
+  while (true) {
+    // parsing merges, so start each record from empty
+    record.Clear();
+    if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(&record, stream, &clean_eof)) break;
+    const WrapperHandTracking& wrapper = record.frame();
+    ReplayFrame frame;
+    int64 timestamp = wrapper.has_timestamp_usec() ? wrapper.timestamp_usec() : record.receive_usec();
+    frame.timestamp_usec = std::max(timestamp, last_timestamp + 1);
+    last_timestamp = frame.timestamp_usec;
+    frame.has_landmarks = wrapper.has_landmarks();
+    frame.landmarks = wrapper.landmarks();
+    frame.has_rect = wrapper.has_rect();
+    frame.rect = wrapper.rect();
+    frame.has_detections = wrapper.has_detection();
+    frame.detections.assign(wrapper.detection().detection().begin(), wrapper.detection().detection().end());
+    frames->push_back(std::move(frame));
+  }
+  if (!clean_eof) {
+    fprintf(stderr, "%s: not a capture file, or cut short after %zu frames\n", path.c_str(), frames->size());
+    return false;
+  }
+  return true;
+}
+
+// A hand waving in front of the camera, the same every run.
+void SynthesizeFrames(int num_frames, double fps, int detections_every, std::vector<ReplayFrame>* frames) {
+  for (int f = 0; f < num_frames; ++f) {
+    double t = f / fps;
+    ReplayFrame frame;
+    frame.timestamp_usec = (int64)llround(t * 1000000);
+    float cx = 0.5f + 0.2f * sinf(t * 1.3);
+    float cy = 0.5f + 0.15f * cosf(t * 0.9);
+    frame.has_landmarks = frame.has_rect = true;
+    for (int i = 0; i < 21; ++i) {
+      NormalizedLandmark* landmark = frame.landmarks.add_landmark();
+      landmark->set_x(cx + 0.1f * cosf(i * 0.3f + t * 4));
+      landmark->set_y(cy + 0.1f * sinf(i * 0.3f + t * 4) - 0.005f * i);
+      landmark->set_z(-0.002f * i);
+    }
+    frame.rect.set_x_center(cx);
+    frame.rect.set_y_center(cy);
+    frame.rect.set_width(0.3f);
+    frame.rect.set_height(0.3f);
+    frame.rect.set_rotation(0.2f * sinf(t));
+    if (detections_every > 0 && f % detections_every == 0) {
+      Detection detection;
+      detection.add_score(0.9f);
+      detection.add_label_id(0);
+      LocationData* location = detection.mutable_location_data();
+      location->set_format(LocationData::RELATIVE_BOUNDING_BOX);
+      location->mutable_relative_bounding_box()->set_xmin(cx - 0.1f);
+      location->mutable_relative_bounding_box()->set_ymin(cy - 0.1f);
+      location->mutable_relative_bounding_box()->set_width(0.2f);
+      location->mutable_relative_bounding_box()->set_height(0.2f);
+      for (int k = 0; k < 7; ++k) {
+        auto* keypoint = location->add_relative_keypoints();
+        keypoint->set_x(cx + 0.01f * k);
+        keypoint->set_y(cy - 0.01f * k);
+      }
+      frame.has_detections = true;
+      frame.detections.push_back(detection);
+    }
+    frames->push_back(std::move(frame));
+  }
+}
+
+// Catches the calculator's datagrams on PORT while a run is going.
+class DatagramSink {
+ public:
+  bool Open() {
+    fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    int size = 8 * 1024 * 1024;
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = INADDR_ANY;
+    if (fd_ < 0 || bind(fd_, (const struct sockaddr*)&addr, sizeof(addr)) != 0) {
+      fprintf(stderr, "can't listen on port %d (%s): stop any receiver there, bytes sent won't be counted\n", PORT, strerror(errno));
+      if (fd_ >= 0) close(fd_);
+      fd_ = -1;
+      return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&DatagramSink::Drain, this);
+    return true;
+  }
+
+  // stops once the last datagram has been read
+  void Close() {
+    if (fd_ < 0) return;
+    running_ = false;
+    thread_.join();
+    close(fd_);
+    fd_ = -1;
+  }
+
+  void Reset() { datagrams_ = bytes_ = 0; }
+  uint64 datagrams() const { return datagrams_; }
+  uint64 bytes() const { return bytes_; }
+
+ private:
+  void Drain() {
+    char buffer[65536];
+    while (true) {
+      struct pollfd p = {fd_, POLLIN, 0};
+      if (poll(&p, 1, 50) <= 0) {
+        if (!running_) break;
+        continue;
+      }
+      ssize_t n = recv(fd_, buffer, sizeof(buffer), 0);
+      if (n > 0) {
+        datagrams_++;
+        bytes_ += n;
+      }
+    }
+  }
+
+  int fd_ = -1;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<uint64> datagrams_{0};
+  std::atomic<uint64> bytes_{0};
+};
+
+// Runs the frames through `calculator` once; returns the wall time in ns,
+// or -1 if the graph failed. `packets_out` counts the landmark packets
+// passed through.
+int64 RunOnce(const std::string& calculator, const std::vector<ReplayFrame>& frames, size_t* packets_out) {
+  char node[1024];
+  snprintf(node, sizeof(node), kNodeTemplate, calculator.c_str());
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(node));
+  auto& landmarks = runner.MutableInputs()->Tag("LANDMARKS").packets;
+  auto& rects = runner.MutableInputs()->Tag("NORM_RECT").packets;
+  auto& detections = runner.MutableInputs()->Tag("DETECTIONS").packets;
+  for (const ReplayFrame& frame : frames) {
+    Timestamp timestamp(frame.timestamp_usec);
+    if (frame.has_landmarks)
+      landmarks.push_back(MakePacket<NormalizedLandmarkList>(frame.landmarks).At(timestamp));
+    if (frame.has_rect)
+      rects.push_back(MakePacket<NormalizedRect>(frame.rect).At(timestamp));
+    if (frame.has_detections)
+      detections.push_back(MakePacket<std::vector<Detection>>(frame.detections).At(timestamp));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  ::mediapipe::Status status = runner.Run();
+  int64 elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  if (!status.ok()) {
+    fprintf(stderr, "%s: %s\n", calculator.c_str(), status.ToString().c_str());
+    return -1;
+  }
+  *packets_out = runner.Outputs().Tag("LANDMARKS").packets.size();
+  return elapsed;
+}
+
+double Median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+int Run(int argc, char** argv) {
+  std::string capture_path;
+  int num_frames = 10000;
+  double fps = 30;
+  int detections_every = 30;
+  int repetitions = 5;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--capture" && has_value) capture_path = argv[++i];
+    else if (arg == "--frames" && has_value) num_frames = atoi(argv[++i]);
+    else if (arg == "--fps" && has_value) fps = atof(argv[++i]);
+    else if (arg == "--detections-every" && has_value) detections_every = atoi(argv[++i]);
+    else if (arg == "--repetitions" && has_value) repetitions = std::max(1, atoi(argv[++i]));
+    else {
+      fprintf(stderr, "usage: %s [--capture FILE] [--frames N] [--fps N] [--detections-every N] [--repetitions N]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<ReplayFrame> frames;
+  if (!capture_path.empty()) {
+    if (!LoadCapture(capture_path, &frames)) return EXIT_FAILURE;
+    if (num_frames > 0 && (size_t)num_frames < frames.size()) frames.resize(num_frames);
+  } else {
+    SynthesizeFrames(num_frames, fps, detections_every, &frames);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "no frames to replay\n");
+    return EXIT_FAILURE;
+  }
+  size_t with_detections = std::count_if(frames.begin(), frames.end(), [](const ReplayFrame& f) { return f.has_detections; });
+  size_t with_landmarks = std::count_if(frames.begin(), frames.end(), [](const ReplayFrame& f) { return f.has_landmarks; });
+  printf("replaying %zu frames (%zu with detections) from %s, %d repetitions\n",
+         frames.size(), with_detections, capture_path.empty() ? "a synthetic hand" : capture_path.c_str(), repetitions);
+
+  DatagramSink sink;
+  bool counting = sink.Open();
+
+  std::vector<double> exporter_ns, stock_ns;
+  uint64 datagrams = 0, bytes = 0;
+  for (int r = 0; r < repetitions; ++r) {
+    size_t exported = 0, passed = 0;
+    sink.Reset();
+    int64 exporter = RunOnce("MyPassThroughCalculator", frames, &exported);
+    int64 stock = RunOnce("PassThroughCalculator", frames, &passed);
+    if (exporter < 0 || stock < 0) return EXIT_FAILURE;
+    if (exported != with_landmarks || passed != with_landmarks) {
+      fprintf(stderr, "expected %zu landmark packets out, got %zu (MyPassThroughCalculator) and %zu (PassThroughCalculator)\n",
+              with_landmarks, exported, passed);
+      return EXIT_FAILURE;
+    }
+    exporter_ns.push_back((double)exporter / frames.size());
+    stock_ns.push_back((double)stock / frames.size());
+    // let the sink catch up with the last datagrams
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    datagrams = sink.datagrams();
+    bytes = sink.bytes();
+  }
+  sink.Close();
+
+  double exporter_median = Median(exporter_ns);
+  double stock_median = Median(stock_ns);
+  printf("MyPassThroughCalculator   %9.0f ns/packet (median), %9.0f best\n", exporter_median, *std::min_element(exporter_ns.begin(), exporter_ns.end()));
+  printf("PassThroughCalculator     %9.0f ns/packet (median), %9.0f best\n", stock_median, *std::min_element(stock_ns.begin(), stock_ns.end()));
+  printf("exporter cost             %9.0f ns/packet\n", exporter_median - stock_median);
+  if (counting)
+    printf("sent                      %9llu datagrams, %llu bytes, %.1f bytes/frame (last repetition)\n",
+           (unsigned long long)datagrams, (unsigned long long)bytes, datagrams ? (double)bytes / datagrams : 0.0);
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace mediapipe
+
+int main(int argc, char** argv) {
+  return mediapipe::Run(argc, argv);
+}
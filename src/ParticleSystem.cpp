@@ -0,0 +1,383 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+#include "nearestAttractor.h"
+
+// stands in for ofSignedNoise(a, b, t): time scrolls the lookup diagonally
+// through the (2d) field instead of being a third dimension
+static inline float noise_at(const noiseField& noise, float a, float b, float t){
+    return noise.sample(a + t, b + 0.5f * t);
+}
+
+//------------------------------------------------------------------
+static inline int round_to_align(int n){
+    return (n + PARTICLE_CHUNK_ALIGN - 1) / PARTICLE_CHUNK_ALIGN * PARTICLE_CHUNK_ALIGN;
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::setup(int max_num, int num_pooled){
+    // round up to whole cache lines, so the permanent particles start on
+    // one; the extra pool slots are just more pool
+    pool_size = round_to_align(num_pooled);
+    max_permanent = std::max(0, max_num);
+    int total = pool_size + round_to_align(max_permanent);
+    x.assign(total, PARTICLE_PARKED);
+    y.assign(total, PARTICLE_PARKED);
+    vx.assign(total, 0);
+    vy.assign(total, 0);
+    drag.assign(total, 0);
+    uniqueVal.assign(total, 0);
+    life.assign(total, 0);
+    
+    // everything starts out dead until reset() places it
+    num_permanent = max_permanent;
+    active_end = total;
+    num_placed = 0;
+    reset_next = num_permanent;
+    free_list.clear();
+    free_list.reserve(pool_size);
+    for (int i=pool_size - 1; i>=0; i--)
+        free_list.push_back(i);
+    
+    if (!noise.isSetup())
+        noise.setup();
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::setNumParticles(int num){
+    
+    num = std::min(std::max(num, 0), max_permanent);
+    
+    // park the ones that drop out, so they're ready if they come back
+    for (int i=pool_size + num; i<active_end; i++){
+        x[i] = y[i] = PARTICLE_PARKED;
+        vx[i] = vy[i] = 0;
+        life[i] = 0;
+    }
+    num_permanent = num;
+    active_end = pool_size + round_to_align(num);
+    num_placed = std::min(num_placed, num);
+    reset_next = std::min(reset_next, num);
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::setSeed(uint32_t seed){
+    rng.seed(seed);
+}
+
+//------------------------------------------------------------------
+int ParticleSystem::getNumAlive() const{
+    return num_placed + (pool_size - (int)free_list.size());
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::reset(particleMode mode, float width, float height){
+    
+    this->mode = mode;
+    reset_mode = mode;
+    reset_width = width;
+    reset_height = height;
+    reset_next = 0;
+    
+    // spawned particles just go back to the pool
+    free_list.clear();
+    for (int i=pool_size - 1; i>=0; i--){
+        x[i] = y[i] = PARTICLE_PARKED;
+        vx[i] = vy[i] = 0;
+        life[i] = 0;
+        free_list.push_back(i);
+    }
+    std::fill(emit_carry, emit_carry + PARTICLE_MAX_EMITTERS, 0);
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::reset_batch(){
+    
+    std::uniform_real_distribution<float> unit(0, 1);
+    auto random = [&](float lo, float hi){ return lo + (hi - lo) * unit(rng); };
+    
+    int end = std::min(reset_next + PARTICLE_RESET_BATCH, num_permanent);
+    for (int i=pool_size + reset_next; i<pool_size + end; i++){
+        //the unique val allows us to set properties slightly differently for each particle
+        uniqueVal[i] = random(-10000, 10000);
+        
+        x[i] = random(0, reset_width);
+        y[i] = random(0, reset_height);
+        
+        vx[i] = random(-vel_max, vel_max);
+        vy[i] = random(-vel_max, vel_max);
+        
+        if (reset_mode == PARTICLE_MODE_NOISE){
+            drag[i] = random(0.97, 0.99);
+            vy[i] = fabsf(vy[i]) * 3.0f; //make the particles all be going down
+        }
+        else{
+            drag[i] = random(0.90, 0.95);
+        }
+        life[i] = PARTICLE_LIFE_FOREVER;
+    }
+    reset_next = end;
+    num_placed = std::max(num_placed, end);
+}
+
+//------------------------------------------------------------------
+bool ParticleSystem::spawn(float x, float y, float vx, float vy, float lifetime){
+    
+    if (free_list.empty())
+        return false;
+    int i = free_list.back();
+    free_list.pop_back();
+    
+    std::uniform_real_distribution<float> unit(0, 1);
+    this->x[i] = x;
+    this->y[i] = y;
+    this->vx[i] = vx;
+    this->vy[i] = vy;
+    drag[i] = 0.90f + 0.05f * unit(rng);
+    uniqueVal[i] = -10000 + 20000 * unit(rng);
+    life[i] = lifetime;
+    return true;
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::emit(const ParticleFrameContext& frame){
+    
+    std::uniform_real_distribution<float> unit(0, 1);
+    int num_emitters = std::min(frame.num_emitters, PARTICLE_MAX_EMITTERS);
+    for (int e=0; e<num_emitters; e++){
+        const particleEmitter& emitter = frame.emitters[e];
+        
+        // carry the fraction over, so low rates still emit
+        emit_carry[e] += emitter.rate * frame.dt;
+        int count = (int)emit_carry[e];
+        emit_carry[e] -= count;
+        
+        for (int k=0; k<count; k++){
+            float angle = unit(rng) * 6.2831853f;
+            float speed = emitter.speed * (0.5f + 0.5f * unit(rng));
+            if (!spawn(emitter.x, emitter.y, cosf(angle) * speed, sinf(angle) * speed, emitter.lifetime))
+                return;
+        }
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::collect_dead(){
+    
+    // only pool slots can die; a dead one that isn't parked yet just expired
+    for (int i=0; i<pool_size; i++){
+        if (life[i] <= 0 && x[i] != PARTICLE_PARKED){
+            x[i] = y[i] = PARTICLE_PARKED;
+            vx[i] = vy[i] = 0;
+            free_list.push_back(i);
+        }
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::set_attract_points(const float* xs, const float* ys, int num){
+    
+    // the points themselves are read straight from the frame; only many of
+    // them need indexing
+    if (num >= PARTICLE_GRID_MIN_ATTRACTORS){
+        if (attract_grid.getCellSize() != PARTICLE_REPEL_RADIUS)
+            attract_grid.setup(PARTICLE_REPEL_RADIUS);
+        attract_grid.build(xs, ys, num);
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update(const ParticleFrameContext& frame){
+    
+    mode = frame.mode;
+    if (reset_next < num_permanent)
+        reset_batch();
+    emit(frame);
+    if (mode == PARTICLE_MODE_NEAREST_POINTS)
+        set_attract_points(frame.attract_x, frame.attract_y, frame.num_attractors);
+    
+    // every particle only touches its own slots, so chunks can run on any
+    // thread in any order and still give the same result
+    auto step = [&](int begin, int end){
+        update_range(begin, end, frame);
+    };
+    if (threads)
+        threads->parallel_for(size(), PARTICLE_CHUNK_SIZE, step);
+    else
+        step(0, size());
+    
+    collect_dead();
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update_range(int begin, int end, const ParticleFrameContext& frame){
+    
+    //1 - APPLY THE FORCES BASED ON WHICH MODE WE ARE IN
+    switch (frame.mode){
+        case PARTICLE_MODE_ATTRACT:
+            update_attract(begin, end, frame);
+            break;
+        case PARTICLE_MODE_REPEL:
+            update_repel(begin, end, frame);
+            break;
+        case PARTICLE_MODE_NOISE:
+            update_noise(begin, end, frame);
+            break;
+        case PARTICLE_MODE_NEAREST_POINTS:
+            update_nearest_points(begin, end, frame);
+            break;
+    }
+    
+    //2 - UPDATE OUR POSITION, keeping the particles on screen
+    integrate(begin, end, frame);
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update_attract(int begin, int end, const ParticleFrameContext& frame){
+    
+    float target_x = frame.target_x;
+    float target_y = frame.target_y;
+    const float* __restrict px = x.data();
+    const float* __restrict py = y.data();
+    const float* __restrict pd = drag.data();
+    float* __restrict pvx = vx.data();
+    float* __restrict pvy = vy.data();
+    
+    // by normalizing we disregard how close the particle is to the attraction point
+    for (int i=begin; i<end; i++){
+        float fx = target_x - px[i];
+        float fy = target_y - py[i];
+        float len = sqrtf(fx * fx + fy * fy);
+        float inv = len > 0 ? 1.0f / len : 0;
+        
+        pvx[i] = pvx[i] * pd[i] + fx * inv * 0.6f;
+        pvy[i] = pvy[i] * pd[i] + fy * inv * 0.6f;
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update_repel(int begin, int end, const ParticleFrameContext& frame){
+    
+    // only repel points close to the target, the rest drift around on noise
+    float target_x = frame.target_x;
+    float target_y = frame.target_y;
+    float t = frame.time * 0.2f;
+    for (int i=begin; i<end; i++){
+        float fx = target_x - x[i];
+        float fy = target_y - y[i];
+        float dist = sqrtf(fx * fx + fy * fy);
+        
+        vx[i] *= drag[i];
+        vy[i] *= drag[i];
+        if (dist < 150){
+            float inv = dist > 0 ? 1.0f / dist : 0;
+            vx[i] -= fx * inv * 0.6f;
+            vy[i] -= fy * inv * 0.6f;
+        }
+        else{
+            vx[i] += noise_at(noise, uniqueVal[i], y[i] * 0.01f, t) * 0.04f;
+            vy[i] += noise_at(noise, uniqueVal[i], x[i] * 0.01f, t) * 0.04f;
+        }
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update_noise(int begin, int end, const ParticleFrameContext& frame){
+    
+    //lets simulate falling snow
+    //the fake wind is meant to add a shift to the particles based on where in x they are
+    //we add y as an arg so to prevent obvious vertical banding around x values
+    float wind_t = frame.time * 0.6f;
+    float t = frame.time * 0.2f;
+    float height = frame.height;
+    for (int i=begin; i<end; i++){
+        float fakeWindX = noise_at(noise, x[i] * 0.003f, y[i] * 0.006f, wind_t);
+        float fx = fakeWindX * 0.25f + noise.sample(uniqueVal[i], y[i] * 0.04f) * 0.6f;
+        float fy = noise_at(noise, uniqueVal[i], x[i] * 0.006f, t) * 0.09f + 0.18f;
+        
+        vx[i] = vx[i] * drag[i] + fx * 0.4f;
+        vy[i] = vy[i] * drag[i] + fy * 0.4f;
+        
+        //skip the bounds check for the bottom and make the particles go back to the top of the screen
+        if (y[i] + vy[i] > height)
+            y[i] -= height;
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::update_nearest_points(int begin, int end, const ParticleFrameContext& frame){
+    
+    int num_attractors = frame.num_attractors;
+    if (num_attractors == 0)
+        return;
+    
+    const float* ax = frame.attract_x;
+    const float* ay = frame.attract_y;
+    float t = frame.time * 0.2f;
+    
+    // work through the particles in blocks small enough for the stack
+    const int block = 256;
+    int closest[block];
+    float closestDist[block];
+    
+    for (int start=begin; start<end; start+=block){
+        int count = std::min(block, end - start);
+        
+        //1 - find closest attractPoint. Only the ones within the repel radius
+        //    matter, so with many attractors look them up in the grid (closest
+        //    is -1 if there's none); otherwise test them all (vectorized, see
+        //    nearestAttractor.h), which is faster for a couple of hands.
+        if (num_attractors >= PARTICLE_GRID_MIN_ATTRACTORS)
+            attract_grid.nearest(&x[start], &y[start], count, PARTICLE_REPEL_RADIUS, closest, closestDist);
+        else
+            find_nearest_attractors(&x[start], &y[start], count, ax, ay, num_attractors, closest, closestDist);
+        
+        //2 - push away from it when close, otherwise wander on noise.
+        //    (drag is applied twice in this mode, as in the original demo)
+        for (int k=0; k<count; k++){
+            int i = start + k;
+            float d = drag[i] * drag[i];
+            vx[i] *= d;
+            vy[i] *= d;
+            if (closestDist[k] < PARTICLE_REPEL_RADIUS * PARTICLE_REPEL_RADIUS){
+                //in this case we don't normalize as we want to have the force proportional to distance
+                vx[i] -= (ax[closest[k]] - x[i]) * 0.03f;
+                vy[i] -= (ay[closest[k]] - y[i]) * 0.03f;
+            }
+            else{
+                vx[i] += noise_at(noise, uniqueVal[i], y[i] * 0.01f, t) * 0.04f;
+                vy[i] += noise_at(noise, uniqueVal[i], x[i] * 0.01f, t) * 0.04f;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------
+void ParticleSystem::integrate(int begin, int end, const ParticleFrameContext& frame){
+    
+    float width = frame.width;
+    float height = frame.height;
+    float* __restrict px = x.data();
+    float* __restrict py = y.data();
+    float* __restrict pvx = vx.data();
+    float* __restrict pvy = vy.data();
+    float* __restrict pl = life.data();
+    float dt = frame.dt;
+    
+    //bounce off the edges (written without branches so it vectorizes);
+    //dead particles stay parked
+    for (int i=begin; i<end; i++){
+        bool alive = pl[i] > 0;
+        pl[i] -= dt;
+        float nx = px[i] + pvx[i];
+        float ny = py[i] + pvy[i];
+        float bx = (nx > width || nx < 0) ? -pvx[i] : pvx[i];
+        float by = (ny > height || ny < 0) ? -pvy[i] : pvy[i];
+        nx = nx > width ? width : (nx < 0 ? 0 : nx);
+        ny = ny > height ? height : (ny < 0 ? 0 : ny);
+        pvx[i] = alive ? bx : pvx[i];
+        pvy[i] = alive ? by : pvy[i];
+        px[i] = alive ? nx : px[i];
+        py[i] = alive ? ny : py[i];
+    }
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#include <new>
+#include <random>
+#include <vector>
+#include "noiseField.h"
+#include "spatialGrid.h"
+#include "threadPool.h"
+
+/**
+ Particle system in struct-of-arrays form.
+ 
+ Replaces the per-object demoParticle (ripped from openFrameworks/examples/
+ math/particlesExample): positions, velocities, drag and the per-particle
+ noise offset live in contiguous float arrays, and update() picks the mode
+ once and then runs one tight loop over all particles, which the compiler
+ can vectorize.
+ 
+ Given a threadPool, update() splits the particles into chunks that start on
+ a cache line boundary and runs them in parallel. Particles don't interact,
+ so the result doesn't depend on the number of threads: with a fixed seed
+ the simulation is repeatable.
+ 
+ The arrays are a fixed pool: setup() allocates every slot once, for the
+ most permanent particles there will ever be. The first slots are spawned
+ by emitters with a lifetime, taken from a free list and handed back when
+ they die; after them come the permanent particles. setNumParticles()
+ changes how many of those take part without allocating: the rest stay
+ parked past size(), and nothing walks over them.
+ Dead and not yet placed particles are parked far off screen and don't move.
+ reset() doesn't re-scatter everything at once: it works through the
+ permanent particles a batch per update, so big counts don't hitch.
+ 
+ Everything the update depends on (time, bounds, target, attractors) comes
+ in once per frame through a ParticleFrameContext, and the wandering forces
+ sample a precomputed noiseField instead of evaluating noise per particle,
+ so the inner loops only touch the particle arrays and no global state.
+ 
+ The simulation doesn't draw anything; ofApp reads x/y to render.
+ */
+
+// particles per parallel chunk, and the granularity particle counts are
+// rounded up to (16 floats = one 64 byte cache line)
+#define PARTICLE_CHUNK_SIZE 4096
+#define PARTICLE_CHUNK_ALIGN 16
+
+// in PARTICLE_MODE_NEAREST_POINTS particles closer than this to their nearest
+// attractor get pushed away. With at least PARTICLE_GRID_MIN_ATTRACTORS
+// attractors the lookup goes through a spatialGrid instead of testing them all.
+#define PARTICLE_REPEL_RADIUS 50
+#define PARTICLE_GRID_MIN_ATTRACTORS 160
+
+// particles reset() re-scatters per update, and where dead particles wait
+#define PARTICLE_RESET_BATCH 32768
+#define PARTICLE_PARKED -10000.0f
+#define PARTICLE_LIFE_FOREVER 1e30f
+#define PARTICLE_MAX_EMITTERS 32
+
+// std::allocator that hands out cache line aligned blocks
+template <class T>
+struct cacheAlignedAllocator{
+    typedef T value_type;
+    cacheAlignedAllocator() {}
+    template <class U> cacheAlignedAllocator(const cacheAlignedAllocator<U>&) {}
+#ifdef _WIN32
+    T* allocate(size_t n){
+        void* p = _aligned_malloc(n * sizeof(T), 64);
+        if (!p)
+            throw std::bad_alloc();
+        return (T*)p;
+    }
+    void deallocate(T* p, size_t){ _aligned_free(p); }
+#else
+    T* allocate(size_t n){
+        void* p = nullptr;
+        if (posix_memalign(&p, 64, n * sizeof(T)) != 0)
+            throw std::bad_alloc();
+        return (T*)p;
+    }
+    void deallocate(T* p, size_t){ free(p); }
+#endif
+    template <class U> bool operator==(const cacheAlignedAllocator<U>&) const { return true; }
+    template <class U> bool operator!=(const cacheAlignedAllocator<U>&) const { return false; }
+};
+typedef std::vector<float, cacheAlignedAllocator<float>> particleArray;
+
+enum particleMode{
+    PARTICLE_MODE_ATTRACT = 0,
+    PARTICLE_MODE_REPEL,
+    PARTICLE_MODE_NEAREST_POINTS,
+    PARTICLE_MODE_NOISE
+};
+
+// sprays particles from a point (e.g. a fingertip) in random directions
+struct particleEmitter{
+    float x = 0;
+    float y = 0;
+    float rate = 200;                   // particles per second
+    float speed = 2;                    // initial speed, pixels per step
+    float lifetime = 2;                 // seconds
+};
+
+// everything one update needs, captured once per frame
+struct ParticleFrameContext{
+    particleMode mode = PARTICLE_MODE_NEAREST_POINTS;
+    float target_x = 0;                 // attract/repel point (the mouse)
+    float target_y = 0;
+    float time = 0;                     // seconds, drives the noise
+    float dt = 1 / 60.0f;               // seconds since the last update (ages particles)
+    float width = 0;                    // the particles stay inside these bounds
+    float height = 0;
+    
+    // attraction points for PARTICLE_MODE_NEAREST_POINTS
+    const float* attract_x = nullptr;
+    const float* attract_y = nullptr;
+    int num_attractors = 0;
+    
+    // at most PARTICLE_MAX_EMITTERS, spawning into the pool
+    const particleEmitter* emitters = nullptr;
+    int num_emitters = 0;
+};
+
+class ParticleSystem{
+
+    public:
+        // room for max_num permanent particles plus num_pooled slots for
+        // emitters, each rounded up to a multiple of PARTICLE_CHUNK_ALIGN.
+        // Nothing is allocated after this. All max_num take part to start with.
+        void setup(int max_num, int num_pooled = 0);
+        // how many permanent particles take part, up to setup()'s max_num; the
+        // others are parked. New ones are scattered over the last reset()'s
+        // area over the next few updates.
+        void setNumParticles(int num);
+        int getNumParticles() const { return num_permanent; }
+        // slots in use (the pool and the active permanent particles), and all of them
+        int size() const { return active_end; }
+        int capacity() const { return (int)x.size(); }
+        int getNumAlive() const;
+    
+        // seed for reset(); the same seed gives the same run
+        void setSeed(uint32_t seed);
+    
+        // update on these threads (nullptr: on the calling thread)
+        void setThreadPool(threadPool* pool) { threads = pool; }
+    
+        // scatter the permanent particles over a width x height area (over the
+        // next few updates) and kill the spawned ones
+        void reset(particleMode mode, float width, float height);
+    
+        // takes a slot off the free list; false if the pool is full
+        bool spawn(float x, float y, float vx, float vy, float lifetime);
+    
+        // one simulation step
+        void update(const ParticleFrameContext& frame);
+    
+        particleArray x;
+        particleArray y;
+        particleArray vx;
+        particleArray vy;
+        particleArray drag;
+        particleArray uniqueVal;        // lets each particle sample the noise a little differently
+        particleArray life;             // seconds left: infinite for permanent particles, 0 when dead
+    
+        spatialGrid attract_grid;       // cell size PARTICLE_REPEL_RADIUS, rebuilt every update
+        noiseField noise;
+    
+        float scale = 1;
+        float vel_max = 1.1;
+        particleMode mode = PARTICLE_MODE_NEAREST_POINTS;
+    
+    private:
+        void set_attract_points(const float* xs, const float* ys, int num);
+        void reset_batch();
+        void emit(const ParticleFrameContext& frame);
+        void collect_dead();
+        void update_range(int begin, int end, const ParticleFrameContext& frame);
+        void update_attract(int begin, int end, const ParticleFrameContext& frame);
+        void update_repel(int begin, int end, const ParticleFrameContext& frame);
+        void update_noise(int begin, int end, const ParticleFrameContext& frame);
+        void update_nearest_points(int begin, int end, const ParticleFrameContext& frame);
+        void integrate(int begin, int end, const ParticleFrameContext& frame);
+    
+        std::mt19937 rng;
+        threadPool* threads = nullptr;
+    
+        int pool_size = 0;              // slots [0, pool_size) are the emitter pool
+        int max_permanent = 0;
+        int num_permanent = 0;          // active permanent particles, from pool_size on
+        int active_end = 0;             // pool_size + num_permanent, rounded up
+        int num_placed = 0;             // permanent particles placed by a reset so far
+        std::vector<int> free_list;     // dead pool slots, capacity reserved in setup()
+        float emit_carry[PARTICLE_MAX_EMITTERS] = {};
+    
+        // reset() in progress: permanent particles [reset_next, num_permanent) to
+        // go, counted from pool_size
+        int reset_next = 0;
+        particleMode reset_mode = PARTICLE_MODE_NEAREST_POINTS;
+        float reset_width = 0;
+        float reset_height = 0;
+};
@@ -1,39 +0,0 @@
-#pragma once
-#include "ofMain.h"
-
-/**
- Particle class ripped from openFrameworks/examples/math/particlesExample
- */
-
-enum particleMode{
-	PARTICLE_MODE_ATTRACT = 0,
-	PARTICLE_MODE_REPEL,
-	PARTICLE_MODE_NEAREST_POINTS,
-	PARTICLE_MODE_NOISE
-};
-
-class demoParticle{
-
-	public:
-		demoParticle();
-		
-		void setMode(particleMode newMode);	
-		void setAttractPoints( vector <ofPoint> * attract );
-
-		void reset();
-		void update();
-		void draw();		
-		
-		ofPoint pos;
-		ofPoint vel;
-		ofPoint frc;
-		
-		float drag; 
-		float uniqueVal;
-		float scale;
-        float vel_max = 1.1;
-		
-		particleMode mode;
-		
-		vector <ofPoint> * attractPoints; 
-};
@@ -0,0 +1,129 @@
+#include "handBackpressure.h"
+#include <algorithm>
+
+// a backlog of this many datagrams' worth of frames, or this much loss,
+// means slow down
+#define BACKPRESSURE_QUEUE_DEPTH 3
+#define BACKPRESSURE_LOSS_PERCENT 2.0f
+// getting this many times what it uses means the receiver throws frames away
+#define BACKPRESSURE_OVERSUPPLY 1.2f
+// feedbacks in a row without either before the full encoding comes back
+#define BACKPRESSURE_CALM_FOR_FULL 8
+// no feedback for this long: back to normal
+#define BACKPRESSURE_TIMEOUT_USEC 2000000
+
+//--------------------------------------------------------------
+void handFeedback::received(int frames, int datagrams){
+    frames_received += frames;
+    datagrams_received += datagrams;
+    queue_depth = std::max(queue_depth, frames);
+}
+
+//--------------------------------------------------------------
+bool handFeedback::update(int64_t now_usec, uint64_t received_total, uint64_t lost_total, std::string& datagram){
+
+    if (interval_start < 0 || received_total < last_received_total){
+        // first call, or the stats were reset
+        interval_start = now_usec;
+        last_received_total = received_total;
+        last_lost_total = lost_total;
+        return false;
+    }
+    int64_t elapsed = now_usec - interval_start;
+    if (elapsed < interval_usec)
+        return false;
+
+    uint64_t received = received_total - last_received_total;
+    // late frames take back some loss
+    uint64_t lost = lost_total > last_lost_total ? lost_total - last_lost_total : 0;
+    feedback.set_received_per_sec(frames_received * 1000000.0f / elapsed);
+    feedback.set_datagrams_per_sec(datagrams_received * 1000000.0f / elapsed);
+    feedback.set_consumed_per_sec(frames_consumed * 1000000.0f / elapsed);
+    feedback.set_queue_depth(queue_depth);
+    feedback.set_loss_percent(received + lost ? 100.0f * lost / (received + lost) : 0.0f);
+    feedback.SerializeToString(&datagram);
+
+    interval_start = now_usec;
+    frames_received = datagrams_received = frames_consumed = 0;
+    queue_depth = 0;
+    last_received_total = received_total;
+    last_lost_total = lost_total;
+    return true;
+}
+
+//--------------------------------------------------------------
+bool handBackpressure::onFeedback(const char* data, int size, int64_t now_usec){
+
+    if (!feedback.ParseFromArray(data, size) || !feedback.has_consumed_per_sec())
+        return false;
+    last_feedback = now_usec;
+
+    // one batch read at once is not a backlog, so the depth is measured in
+    // datagrams' worth of frames (older receivers only count datagrams)
+    float per_datagram = 1;
+    if (feedback.datagrams_per_sec() > 0)
+        per_datagram = std::max(1.0f, feedback.received_per_sec() / feedback.datagrams_per_sec());
+    bool backlog = feedback.queue_depth() >= BACKPRESSURE_QUEUE_DEPTH * per_datagram || feedback.loss_percent() >= BACKPRESSURE_LOSS_PERCENT;
+    bool oversupply = feedback.consumed_per_sec() > 0 && feedback.received_per_sec() > feedback.consumed_per_sec() * BACKPRESSURE_OVERSUPPLY;
+    float sending = offered_rate > 0 ? offered_rate : feedback.received_per_sec();
+    if (rate_limit > 0)
+        sending = std::min(sending, rate_limit);
+
+    if (backlog || oversupply){
+        // down to what the receiver gets through, with some room to drain
+        float target = feedback.consumed_per_sec() > 0 ? feedback.consumed_per_sec() : sending * 0.5f;
+        rate_limit = std::max(min_rate, std::min(sending, target) * 0.9f);
+        // fewer bytes only help when datagrams pile up or get lost
+        if (backlog){
+            lean = true;
+            calm = 0;
+        }
+        return true;
+    }
+
+    // keeping up: creep back up, until we're not holding anything back
+    calm++;
+    if (rate_limit > 0){
+        rate_limit *= 1.15f;
+        if (offered_rate > 0 && rate_limit >= offered_rate * 1.5f)
+            rate_limit = 0;
+    }
+    if (calm >= BACKPRESSURE_CALM_FOR_FULL)
+        lean = false;
+    return true;
+}
+
+//--------------------------------------------------------------
+bool handBackpressure::shouldSend(int64_t now_usec){
+
+    // measure the incoming frame rate
+    if (offered_start < 0)
+        offered_start = now_usec;
+    offered_frames++;
+    if (now_usec - offered_start >= 1000000){
+        offered_rate = offered_frames * 1000000.0f / (now_usec - offered_start);
+        offered_start = now_usec;
+        offered_frames = 0;
+    }
+
+    if (last_feedback >= 0 && now_usec - last_feedback > BACKPRESSURE_TIMEOUT_USEC){
+        rate_limit = 0;
+        lean = false;
+        last_feedback = -1;
+    }
+
+    int64_t elapsed = last_frame < 0 ? 0 : now_usec - last_frame;
+    last_frame = now_usec;
+    if (rate_limit <= 0){
+        credit = 1;
+        return true;
+    }
+
+    // a little banked, so the rate averages out over uneven frames, but not
+    // so much that a pause turns into a burst
+    credit = std::min(2.0, credit + rate_limit * elapsed / 1000000.0);
+    if (credit < 1)
+        return false;
+    credit -= 1;
+    return true;
+}
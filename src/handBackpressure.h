@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <string>
+// the full path, so the calculator can use this file too
+#include "mediapipe/framework/formats/wrapper_hand_tracking.pb.h"
+
+/**
+ Receiver -> sender backpressure over the same UDP path the frames take.
+
+ The receiver keeps a handFeedback: it counts the frames and datagrams
+ that arrive, how many frames were waiting at once and how many it used, and every quarter
+ second produces a HandTrackingFeedback datagram to send back to the
+ address frames come from.
+
+ The sender keeps a handBackpressure per receiver and hands it every
+ feedback datagram. When the receiver gets more frames than it uses, or
+ reports a backlog or loss, the sender paces itself down to the rate the
+ receiver consumes (never below a floor). A backlog or loss also switches
+ it to the lean encoding: x and y only, no z, which nothing downstream
+ draws. Once the receiver keeps up again the rate creeps back up, and the
+ full encoding returns after two calm seconds. If feedback stops (an older
+ receiver, or none at all) everything goes back to normal.
+ */
+
+#define HAND_FEEDBACK_INTERVAL_USEC 250000
+
+class handFeedback{
+
+    public:
+        void setInterval(int64_t usec){ interval_usec = usec; }
+
+        // one pass over the socket read `datagrams` carrying `frames` (the
+        // queue depth); a batching sender packs several frames per datagram
+        void received(int frames, int datagrams);
+        // frames the receiver used: rendered, or processed
+        void consumed(int frames = 1){ frames_consumed += frames; }
+
+        // true when a feedback datagram is due, serialized into `datagram`.
+        // `received_total` and `lost_total` are the receiver's running
+        // sequence id counts (see receiverStats), for the loss since last time.
+        bool update(int64_t now_usec, uint64_t received_total, uint64_t lost_total, std::string& datagram);
+
+        const ::mediapipe::HandTrackingFeedback& getLast() const { return feedback; }
+
+    private:
+        int64_t interval_usec = HAND_FEEDBACK_INTERVAL_USEC;
+        int64_t interval_start = -1;
+        uint64_t frames_received = 0;
+        uint64_t datagrams_received = 0;
+        uint64_t frames_consumed = 0;
+        int queue_depth = 0;
+        uint64_t last_received_total = 0;
+        uint64_t last_lost_total = 0;
+        ::mediapipe::HandTrackingFeedback feedback;
+};
+
+class handBackpressure{
+
+    public:
+        // the slowest the sender will go, frames per second
+        void setMinRate(float hz){ min_rate = hz; }
+
+        // false if `data` isn't a feedback datagram
+        bool onFeedback(const char* data, int size, int64_t now_usec);
+
+        // once per frame: false if this one should be skipped, to keep to
+        // the receiver's pace
+        bool shouldSend(int64_t now_usec);
+
+        bool useLeanEncoding() const { return lean; }
+        // frames per second, 0 when not limited
+        float getRateLimit() const { return rate_limit; }
+
+    private:
+        float min_rate = 5;
+        float rate_limit = 0;
+        bool lean = false;
+        int calm = 0;                   // feedbacks in a row without a backlog
+        int64_t last_feedback = -1;
+        ::mediapipe::HandTrackingFeedback feedback;
+
+        // the rate frames come in at, measured over about a second
+        float offered_rate = 0;
+        int64_t offered_start = -1;
+        int offered_frames = 0;
+
+        // token bucket for pacing
+        double credit = 1;
+        int64_t last_frame = -1;
+};
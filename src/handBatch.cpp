@@ -0,0 +1,88 @@
+#include "handBatch.h"
+
+// after the 0xff marker
+#define HAND_BATCH_TAG 'B'
+
+//--------------------------------------------------------------
+void handBatcher::setup(int mtu, int64_t flush_usec){
+    this->mtu = mtu;
+    this->flush_usec = flush_usec;
+    buffer.reserve(mtu);
+    clear();
+}
+
+//--------------------------------------------------------------
+bool handBatcher::add(const char* frame, int size, int64_t now_usec){
+
+    if (size > 0xffff || HAND_BATCH_HEADER_SIZE + HAND_BATCH_LENGTH_SIZE + size > mtu)
+        return false;
+    if (num_frames == 0)
+        first_usec = now_usec;
+    buffer.push_back((char)(size & 0xff));
+    buffer.push_back((char)(size >> 8));
+    buffer.append(frame, size);
+    num_frames++;
+    return true;
+}
+
+//--------------------------------------------------------------
+bool handBatcher::needsFlush(int64_t now_usec, int next_size) const{
+    if (num_frames == 0)
+        return false;
+    if (next_size > 0 && (int)buffer.size() + HAND_BATCH_LENGTH_SIZE + next_size > mtu)
+        return true;
+    return now_usec >= first_usec + flush_usec;
+}
+
+//--------------------------------------------------------------
+const char* handBatcher::getData() const{
+    // skip the batch header and length for a lone frame
+    return num_frames == 1 ? buffer.data() + HAND_BATCH_HEADER_SIZE + HAND_BATCH_LENGTH_SIZE : buffer.data();
+}
+
+//--------------------------------------------------------------
+int handBatcher::getSize() const{
+    return num_frames == 1 ? (int)buffer.size() - HAND_BATCH_HEADER_SIZE - HAND_BATCH_LENGTH_SIZE : (int)buffer.size();
+}
+
+//--------------------------------------------------------------
+void handBatcher::clear(){
+    buffer.assign(1, (char)0xff);
+    buffer.push_back(HAND_BATCH_TAG);
+    num_frames = 0;
+}
+
+//--------------------------------------------------------------
+bool handBatchReader::isBatch(const char* data, int size){
+    return size >= HAND_BATCH_HEADER_SIZE && (uint8_t)data[0] == 0xff && data[1] == HAND_BATCH_TAG;
+}
+
+//--------------------------------------------------------------
+void handBatchReader::reset(const char* data, int size){
+    single = !isBatch(data, size);
+    this->data = single ? data : data + HAND_BATCH_HEADER_SIZE;
+    end = data + size;
+}
+
+//--------------------------------------------------------------
+bool handBatchReader::next(const char*& frame, int& size){
+
+    if (single){
+        single = false;
+        frame = data;
+        size = (int)(end - data);
+        data = end;
+        return true;
+    }
+    if (end - data < HAND_BATCH_LENGTH_SIZE)
+        return false;
+    int length = (uint8_t)data[0] | ((uint8_t)data[1] << 8);
+    if (end - data - HAND_BATCH_LENGTH_SIZE < length){
+        data = end;
+        return false;
+    }
+    frame = data + HAND_BATCH_LENGTH_SIZE;
+    size = length;
+    data += HAND_BATCH_LENGTH_SIZE + length;
+    return true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ Several frames packed into one datagram, for high-rate senders (replay,
+ forwarding, aggregation hosts) where per-packet overhead dominates: a hand
+ frame is a few hundred bytes, far below the MTU.
+
+ A batch is the 0xff marker (as in handWire.h) and a 'B' tag, then each
+ frame prefixed with its length as 16 bits little-endian. The frames
+ themselves can be in any wire format. A lone frame is sent as it is, so a
+ batching sender at a low rate looks like any other.
+
+ handBatcher collects frames until the next wouldn't fit in the MTU or the
+ oldest has waited the flush deadline:
+
+   if (batcher.needsFlush(now, size)){ send(batcher.getData(), batcher.getSize()); batcher.clear(); }
+   if (!batcher.add(frame, size, now))
+       send(frame, size);              // too big to batch
+   ...
+   if (batcher.needsFlush(now)){ ... }  // also when idle, by getDeadline()
+
+ handBatchReader walks the frames of any datagram in one pass, handing out
+ pointers into it (a datagram that isn't a batch is one frame).
+ */
+
+#define HAND_BATCH_DEFAULT_MTU 1472             // 1500 byte Ethernet MTU, less IPv4 and UDP headers
+#define HAND_BATCH_DEFAULT_FLUSH_USEC 2000
+#define HAND_BATCH_HEADER_SIZE 2
+#define HAND_BATCH_LENGTH_SIZE 2
+
+class handBatcher{
+
+    public:
+        // `mtu` is the largest datagram to send, `flush_usec` the longest a
+        // frame waits for company
+        void setup(int mtu = HAND_BATCH_DEFAULT_MTU, int64_t flush_usec = HAND_BATCH_DEFAULT_FLUSH_USEC);
+
+        // false (and nothing queued) if the frame is too big for any batch
+        bool add(const char* frame, int size, int64_t now_usec);
+
+        // whether the pending frames should go out now: a frame of
+        // `next_size` bytes wouldn't fit with them, or the deadline passed
+        bool needsFlush(int64_t now_usec, int next_size = 0) const;
+        // when the oldest pending frame is due out, or -1 if none are pending
+        int64_t getDeadline() const { return num_frames ? first_usec + flush_usec : -1; }
+
+        // the datagram to send: the batch, or a lone frame as it is
+        const char* getData() const;
+        int getSize() const;
+        int getNumFrames() const { return num_frames; }
+        void clear();
+
+    private:
+        int mtu = HAND_BATCH_DEFAULT_MTU;
+        int64_t flush_usec = HAND_BATCH_DEFAULT_FLUSH_USEC;
+        std::string buffer;
+        int num_frames = 0;
+        int64_t first_usec = 0;
+};
+
+class handBatchReader{
+
+    public:
+        // a datagram to unpack; `data` must outlive the reader
+        void reset(const char* data, int size);
+        // the next frame, false at the end (or at a truncated length)
+        bool next(const char*& frame, int& size);
+
+        // whether a datagram is a batch
+        static bool isBatch(const char* data, int size);
+
+    private:
+        const char* data = nullptr;
+        const char* end = nullptr;
+        bool single = false;
+};
@@ -0,0 +1,280 @@
+#include "handCapture.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <google/protobuf/util/delimited_message_util.h>
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#endif
+
+using google::protobuf::io::FileInputStream;
+using google::protobuf::io::FileOutputStream;
+using google::protobuf::io::GzipInputStream;
+using google::protobuf::io::GzipOutputStream;
+
+//--------------------------------------------------------------
+static int open_file(const std::string& path, bool write){
+#ifdef _WIN32
+    if (write)
+        return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+    return _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    if (write)
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    return ::open(path.c_str(), O_RDONLY);
+#endif
+}
+
+//--------------------------------------------------------------
+handCaptureWriter::~handCaptureWriter(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool handCaptureWriter::open(const std::string& path, bool use_gzip){
+
+    close();
+    int fd = open_file(path, true);
+    if (fd < 0){
+        error = "can't create " + path;
+        return false;
+    }
+    file.reset(new FileOutputStream(fd));
+    stream = file.get();
+    if (use_gzip){
+        GzipOutputStream::Options options;
+        options.format = GzipOutputStream::GZIP;
+        gzip.reset(new GzipOutputStream(file.get(), options));
+        stream = gzip.get();
+    }
+    num_records = 0;
+    error.clear();
+    return true;
+}
+
+//--------------------------------------------------------------
+void handCaptureWriter::close(){
+
+    // the gzip stream flushes its tail into the file, which then flushes to
+    // disk and closes the descriptor
+    if (gzip)
+        gzip->Close();
+    if (file)
+        file->Close();
+    gzip.reset();
+    file.reset();
+    stream = nullptr;
+}
+
+//--------------------------------------------------------------
+bool handCaptureWriter::write(const ::mediapipe::WrapperHandTracking& frame, int64_t receive_usec, int64_t receive_wall_usec, int source){
+
+    if (!stream)
+        return false;
+
+    record.set_receive_usec(receive_usec);
+    record.set_receive_wall_usec(receive_wall_usec);
+    record.set_source(source);
+    record.mutable_frame()->CopyFrom(frame);
+    if (!google::protobuf::util::SerializeDelimitedToZeroCopyStream(record, stream)){
+        error = "write failed";
+        close();
+        return false;
+    }
+    num_records++;
+    return true;
+}
+
+//--------------------------------------------------------------
+handCaptureReader::~handCaptureReader(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool handCaptureReader::open(const std::string& path){
+
+    close();
+    error.clear();
+    int fd = open_file(path, false);
+    if (fd < 0){
+        error = "can't open " + path;
+        return false;
+    }
+    file.reset(new FileInputStream(fd));
+    file->SetCloseOnDelete(true);
+    stream = file.get();
+
+    // peek at the first two bytes for the gzip magic
+    const void* data;
+    int size;
+    while (file->Next(&data, &size)){
+        if (size == 0)
+            continue;
+        const unsigned char* bytes = (const unsigned char*)data;
+        bool is_gzip = size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b;
+        bool is_indexed = size >= 8 && memcmp(bytes, "HANDCAPX", 8) == 0;
+        file->BackUp(size);
+        if (is_indexed){
+            file.reset();
+            stream = nullptr;
+            if (!indexed.open(path)){
+                error = indexed.getError();
+                return false;
+            }
+            return true;
+        }
+        if (is_gzip){
+            gzip.reset(new GzipInputStream(file.get(), GzipInputStream::GZIP));
+            stream = gzip.get();
+        }
+        break;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void handCaptureReader::close(){
+    indexed.close();
+    gzip.reset();
+    file.reset();
+    stream = nullptr;
+}
+
+//--------------------------------------------------------------
+bool handCaptureReader::read(::mediapipe::HandTrackingCaptureRecord& record){
+
+    if (indexed.isOpen()){
+        if (indexed.read(record))
+            return true;
+        error = indexed.getError();
+        return false;
+    }
+    if (!stream)
+        return false;
+
+    // the parse merges, so start from an empty record
+    record.Clear();
+    bool clean_eof = false;
+    if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(&record, stream, &clean_eof)){
+        if (!clean_eof)
+            error = "damaged record";
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+bool handCaptureReplayer::open(const std::string& path){
+
+    this->path = path;
+    num_replayed = 0;
+    pass_records = 0;
+    time_offset = timestamp_offset = 0;
+    sequence_offset = 0;
+    last_sequence_id = 0;
+    last_timestamp_usec = 0;
+    has_next = false;
+    if (!reader.open(path))
+        return false;
+    if (!read_ahead())
+        return false;
+    restart();
+    return true;
+}
+
+//--------------------------------------------------------------
+bool handCaptureReplayer::seek(int64_t offset_usec){
+
+    if (!reader.isSeekable())
+        return false;
+    reader.seek(reader.getStartUsec() + offset_usec);
+    pass_records = 0;
+    if (!read_ahead())
+        return false;
+    restart();
+    return true;
+}
+
+//--------------------------------------------------------------
+void handCaptureReplayer::restart(){
+
+    // the next record plays at the next call to next()
+    started = false;
+    start_usec = 0;
+    first_receive_usec = pending.receive_usec();
+}
+
+//--------------------------------------------------------------
+bool handCaptureReplayer::read_ahead(){
+
+    if (!reader.read(pending)){
+        // start over, one average frame interval after the last record
+        if (!loop || num_replayed == 0 || !reader.open(path) || !reader.read(pending)){
+            has_next = false;
+            return false;
+        }
+        int64_t intervals = std::max<uint64_t>(1, pass_records - 1);
+        int64_t interval = (last_receive_usec - pass_first_receive_usec) / intervals;
+        time_offset = last_receive_usec + interval - pending.receive_usec();
+
+        auto& frame = pending.frame();
+        if (frame.has_sequence_id())
+            sequence_offset = last_sequence_id + 1 - frame.sequence_id();
+        if (frame.has_timestamp_usec())
+            timestamp_offset = last_timestamp_usec + (last_timestamp_usec - pass_first_timestamp_usec) / intervals - frame.timestamp_usec();
+        pass_records = 0;
+    }
+
+    pending.set_receive_usec(pending.receive_usec() + time_offset);
+    if (pending.has_receive_wall_usec())
+        pending.set_receive_wall_usec(pending.receive_wall_usec() + time_offset);
+    auto* frame = pending.mutable_frame();
+    if (frame->has_send_time_usec())
+        frame->set_send_time_usec(frame->send_time_usec() + time_offset);
+    if (frame->has_sequence_id())
+        frame->set_sequence_id(frame->sequence_id() + sequence_offset);
+    if (frame->has_timestamp_usec())
+        frame->set_timestamp_usec(frame->timestamp_usec() + timestamp_offset);
+    has_next = true;
+    return true;
+}
+
+//--------------------------------------------------------------
+int64_t handCaptureReplayer::getNextDue() const{
+
+    if (!has_next)
+        return 0;
+    if (!started)
+        return start_usec;
+    return start_usec + (int64_t)((pending.receive_usec() - first_receive_usec) / (speed > 0 ? speed : 1));
+}
+
+//--------------------------------------------------------------
+bool handCaptureReplayer::next(int64_t now_usec, ::mediapipe::HandTrackingCaptureRecord& record){
+
+    if (!has_next)
+        return false;
+    if (!started){
+        started = true;
+        start_usec = now_usec;
+    }
+    int64_t due = getNextDue();
+    if (speed > 0 && due > now_usec)
+        return false;
+
+    record.Swap(&pending);
+    last_receive_usec = record.receive_usec();
+    if (pass_records++ == 0){
+        pass_first_receive_usec = record.receive_usec();
+        pass_first_timestamp_usec = record.frame().timestamp_usec();
+    }
+    record.set_receive_usec(due);
+    if (record.frame().has_sequence_id())
+        last_sequence_id = record.frame().sequence_id();
+    if (record.frame().has_timestamp_usec())
+        last_timestamp_usec = record.frame().timestamp_usec();
+    num_replayed++;
+    read_ahead();
+    return true;
+}
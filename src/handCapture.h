@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include "indexedCapture.h"
+#include "wrapper_hand_tracking.pb.h"
+
+/**
+ Record and replay of the hand tracking stream.
+
+ A capture file is a sequence of HandTrackingCaptureRecord messages (the
+ received WrapperHandTracking plus when it arrived), each prefixed with its
+ length as in protobuf's util/delimited_message_util.h, optionally gzipped.
+ The reader detects gzip by its magic bytes, and also reads indexed
+ captures (see indexedCapture.h), which can seek.
+
+ handCaptureReplayer hands the records back out at the pace they were
+ received (or N times faster, or as fast as the caller takes them), so a
+ recorded session can drive the receiver and renderer again without a
+ webcam or MediaPipe, the same way every run.
+ */
+
+class handCaptureWriter{
+
+    public:
+        ~handCaptureWriter();
+
+        // truncates `path`
+        bool open(const std::string& path, bool gzip = false);
+        void close();
+        bool isOpen() const { return stream != nullptr; }
+
+        // receive_usec on a monotonic clock, receive_wall_usec since the epoch
+        bool write(const ::mediapipe::WrapperHandTracking& frame, int64_t receive_usec, int64_t receive_wall_usec, int source = 0);
+
+        uint64_t getNumRecords() const { return num_records; }
+        const std::string& getError() const { return error; }
+
+    private:
+        std::unique_ptr<google::protobuf::io::FileOutputStream> file;
+        std::unique_ptr<google::protobuf::io::GzipOutputStream> gzip;
+        google::protobuf::io::ZeroCopyOutputStream* stream = nullptr;
+        ::mediapipe::HandTrackingCaptureRecord record;
+        uint64_t num_records = 0;
+        std::string error;
+};
+
+class handCaptureReader{
+
+    public:
+        ~handCaptureReader();
+
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return stream != nullptr || indexed.isOpen(); }
+
+        // false at the end of the file or on a damaged record (see getError())
+        bool read(::mediapipe::HandTrackingCaptureRecord& record);
+
+        // indexed captures only: continue at the first record received at or
+        // after receive_usec
+        bool isSeekable() const { return indexed.isOpen(); }
+        void seek(int64_t receive_usec) { indexed.seek(receive_usec); }
+        int64_t getStartUsec() const { return indexed.getStartUsec(); }
+
+        const std::string& getError() const { return error; }
+
+    private:
+        std::unique_ptr<google::protobuf::io::FileInputStream> file;
+        std::unique_ptr<google::protobuf::io::GzipInputStream> gzip;
+        google::protobuf::io::ZeroCopyInputStream* stream = nullptr;
+        indexedCaptureReader indexed;
+        std::string error;
+};
+
+class handCaptureReplayer{
+
+    public:
+        bool open(const std::string& path);
+        void close() { reader.close(); has_next = false; }
+        bool isOpen() const { return has_next; }
+
+        // 1 plays at the recorded pace, 2 twice as fast, 0 as fast as next() is called
+        void setSpeed(double speed) { this->speed = speed; }
+        // start over at the end; sequence ids and all the times carry on
+        // from the last pass so receivers don't mistake the repeat for duplicates
+        void setLoop(bool loop) { this->loop = loop; }
+
+        // jump to offset_usec into the capture (indexed captures only); the
+        // next record plays at the next call to next()
+        bool seek(int64_t offset_usec);
+
+        // the next record, if it's due at now_usec (the caller's monotonic
+        // clock). The first call starts the clock. record.receive_usec is
+        // when the record was due on the caller's clock, which at speed 0 is
+        // as if it played at 1x, so max speed replays see the recorded pacing.
+        bool next(int64_t now_usec, ::mediapipe::HandTrackingCaptureRecord& record);
+
+        // when the next record is due on the caller's clock (0 if nothing is left)
+        int64_t getNextDue() const;
+
+        uint64_t getNumReplayed() const { return num_replayed; }
+        const std::string& getError() const { return reader.getError(); }
+
+    private:
+        bool read_ahead();
+        void restart();
+
+        handCaptureReader reader;
+        std::string path;
+        ::mediapipe::HandTrackingCaptureRecord pending;
+        bool has_next = false;
+        double speed = 1;
+        bool loop = false;
+        uint64_t num_replayed = 0;
+
+        bool started = false;
+        int64_t start_usec = 0;         // caller's clock at the first record
+        int64_t first_receive_usec = 0; // recorded time of the first record
+        int64_t last_receive_usec = 0;
+
+        // this pass through the file, for looping
+        uint64_t pass_records = 0;
+        int64_t pass_first_receive_usec = 0;
+        int64_t pass_first_timestamp_usec = 0;
+
+        // added to every record after a loop
+        int64_t time_offset = 0;
+        uint64_t sequence_offset = 0;
+        int64_t timestamp_offset = 0;
+        uint64_t last_sequence_id = 0;
+        int64_t last_timestamp_usec = 0;
+};
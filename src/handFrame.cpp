@@ -0,0 +1,41 @@
+#include "handFrame.h"
+
+//--------------------------------------------------------------
+bool decode_hand_frame(const char* data, int size, ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame){
+    
+    wrapper.Clear();
+    if (size <= 0 || !wrapper.ParseFromArray(data, size))
+        return false;
+    
+    to_hand_frame(wrapper, frame);
+    return true;
+}
+
+//--------------------------------------------------------------
+void to_hand_frame(const ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame){
+    
+    frame.timestamp_usec = wrapper.timestamp_usec();
+    frame.has_sequence = wrapper.has_sequence_id();
+    frame.sequence_id = wrapper.sequence_id();
+    frame.send_time_usec = wrapper.send_time_usec();
+    
+    int n = wrapper.landmarks().landmark_size();
+    if (n > NUM_HAND_LANDMARKS)
+        n = NUM_HAND_LANDMARKS;
+    frame.num_landmarks = n;
+    for (int i=0; i<n; i++){
+        auto& landmark = wrapper.landmarks().landmark(i);
+        frame.x[i] = landmark.x();
+        frame.y[i] = landmark.y();
+        frame.z[i] = landmark.z();
+    }
+    
+    // an all-zero rect means the sender didn't fill it in
+    auto& rect = wrapper.rect();
+    frame.has_rect = wrapper.has_rect() && rect.x_center() != 0 && rect.y_center() != 0;
+    frame.rect_x_center = rect.x_center();
+    frame.rect_y_center = rect.y_center();
+    frame.rect_width = rect.width();
+    frame.rect_height = rect.height();
+    frame.rect_rotation = rect.rotation();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include "wrapper_hand_tracking.pb.h"
+#include "landmarkTopology.h"
+
+/**
+ One decoded hand tracking frame, kept in normalized image coordinates.
+
+ Plain data with no openFrameworks types, so the same decode path can be used
+ by ofApp and by code that runs without a window.
+ */
+
+#define NUM_HAND_LANDMARKS HAND_NUM_LANDMARKS
+
+struct HandFrame{
+    int source = 0;                 // which sender this came from, if there are several
+    int64_t timestamp_usec = 0;     // sender timestamp (graph packet time)
+    int64_t receive_usec = 0;       // local receive time
+    
+    bool has_sequence = false;      // older senders don't number their messages
+    uint64_t sequence_id = 0;
+    int64_t send_time_usec = 0;     // sender wall clock, since the Unix epoch
+
+    // landmarks, stored as separate x/y/z arrays
+    int num_landmarks = 0;
+    float x[NUM_HAND_LANDMARKS];
+    float y[NUM_HAND_LANDMARKS];
+    float z[NUM_HAND_LANDMARKS];
+
+    // hand rectangle (center, size, rotation in radians)
+    bool has_rect = false;
+    float rect_x_center = 0;
+    float rect_y_center = 0;
+    float rect_width = 0;
+    float rect_height = 0;
+    float rect_rotation = 0;
+};
+
+// parse a datagram into a HandFrame, reusing the wrapper for scratch space
+bool decode_hand_frame(const char* data, int size, ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame);
+
+// copy an already parsed wrapper into a HandFrame
+void to_hand_frame(const ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame);
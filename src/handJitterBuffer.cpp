@@ -0,0 +1,178 @@
+#include "handJitterBuffer.h"
+#include <cmath>
+
+// anything further back than this is treated as a restarted sender
+#define JITTER_BUFFER_RESET_USEC 1000000
+
+//--------------------------------------------------------------
+void handJitterBuffer::setDelay(int64_t delay_usec){
+    delay = delay_usec > 0 ? delay_usec : 0;
+}
+
+//--------------------------------------------------------------
+void handJitterBuffer::setMaxExtrapolation(int64_t usec){
+    max_extrapolation = usec > 0 ? usec : 0;
+}
+
+//--------------------------------------------------------------
+void handJitterBuffer::clear(){
+    head = 0;
+    count = 0;
+    has_offset = false;
+    has_previous = false;
+    last_playout = 0;
+    was_underrun = false;
+}
+
+//--------------------------------------------------------------
+void handJitterBuffer::push(const HandFrame& frame){
+    
+    stats.frames_in++;
+    
+    // sender restarted (or the clock jumped): start over
+    if (count > 0 && frame.timestamp_usec < frames[index(count-1)].timestamp_usec - JITTER_BUFFER_RESET_USEC){
+        clear();
+        stats.resets++;
+    }
+    
+    // track the smallest transit offset we've seen, drifting slowly upward
+    // so that sender/receiver clock skew doesn't accumulate
+    int64_t offset = frame.receive_usec - frame.timestamp_usec;
+    if (!has_offset || offset < clock_offset){
+        clock_offset = offset;
+        has_offset = true;
+    }
+    else{
+        clock_offset += (offset - clock_offset) / 1024;
+    }
+    
+    // too late to be shown
+    if (count > 0 && frame.timestamp_usec <= last_playout){
+        stats.frames_late++;
+        return;
+    }
+    
+    // full: drop the oldest frame
+    if (count == JITTER_BUFFER_SIZE){
+        previous = frames[head];
+        has_previous = true;
+        head = index(1);
+        count--;
+    }
+    
+    // find the slot in timestamp order (frames almost always arrive in
+    // order, so this walks back at most a slot or two)
+    int i = count;
+    while (i > 0 && frames[index(i-1)].timestamp_usec > frame.timestamp_usec)
+        i--;
+    if (i > 0 && frames[index(i-1)].timestamp_usec == frame.timestamp_usec)
+        return; // duplicate
+    
+    for (int j=count; j>i; j--)
+        frames[index(j)] = frames[index(j-1)];
+    frames[index(i)] = frame;
+    count++;
+    
+    stats.buffered = count;
+}
+
+//--------------------------------------------------------------
+bool handJitterBuffer::sample(int64_t now_usec, HandFrame& out){
+    
+    stats.delay_usec = delay;
+    if (count == 0)
+        return false;
+    
+    // playout time, expressed on the sender's clock
+    int64_t t = now_usec - clock_offset - delay;
+    last_playout = t;
+    
+    // retire frames we've moved past, keeping the last one for extrapolation
+    while (count > 1 && frames[index(1)].timestamp_usec <= t){
+        previous = frames[head];
+        has_previous = true;
+        head = index(1);
+        count--;
+    }
+    stats.buffered = count;
+    
+    const HandFrame& first = frames[head];
+    if (t <= first.timestamp_usec){
+        // still waiting for the playout point to reach the oldest frame
+        out = first;
+        was_underrun = false;
+    }
+    else if (count > 1){
+        const HandFrame& next = frames[index(1)];
+        float s = (float)(t - first.timestamp_usec) / (float)(next.timestamp_usec - first.timestamp_usec);
+        interpolate(first, next, s, out);
+        was_underrun = false;
+    }
+    else{
+        // underrun: nothing newer than the playout time
+        if (!was_underrun)
+            stats.underruns++;
+        was_underrun = true;
+        
+        int64_t ahead = t - first.timestamp_usec;
+        if (ahead > max_extrapolation)
+            ahead = max_extrapolation;
+        
+        int64_t span = first.timestamp_usec - previous.timestamp_usec;
+        if (has_previous && span > 0 && ahead > 0){
+            stats.extrapolated++;
+            interpolate(previous, first, 1.0f + (float)ahead / (float)span, out);
+        }
+        else{
+            out = first;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void handJitterBuffer::interpolate(const HandFrame& a, const HandFrame& b, float t, HandFrame& out) const{
+    
+    out.timestamp_usec = a.timestamp_usec + (int64_t)((b.timestamp_usec - a.timestamp_usec) * (double)t);
+    out.receive_usec = b.receive_usec;
+    
+    // the hand can only be blended if both frames saw the same landmarks
+    if (a.num_landmarks == b.num_landmarks){
+        out.num_landmarks = b.num_landmarks;
+        for (int i=0; i<b.num_landmarks; i++){
+            out.x[i] = a.x[i] + (b.x[i] - a.x[i]) * t;
+            out.y[i] = a.y[i] + (b.y[i] - a.y[i]) * t;
+            out.z[i] = a.z[i] + (b.z[i] - a.z[i]) * t;
+        }
+    }
+    else{
+        const HandFrame& nearest = t < 0.5f ? a : b;
+        out.num_landmarks = nearest.num_landmarks;
+        for (int i=0; i<nearest.num_landmarks; i++){
+            out.x[i] = nearest.x[i];
+            out.y[i] = nearest.y[i];
+            out.z[i] = nearest.z[i];
+        }
+    }
+    
+    if (a.has_rect && b.has_rect){
+        out.has_rect = true;
+        out.rect_x_center = a.rect_x_center + (b.rect_x_center - a.rect_x_center) * t;
+        out.rect_y_center = a.rect_y_center + (b.rect_y_center - a.rect_y_center) * t;
+        out.rect_width = a.rect_width + (b.rect_width - a.rect_width) * t;
+        out.rect_height = a.rect_height + (b.rect_height - a.rect_height) * t;
+        
+        // rotate the short way round
+        float d = remainderf(b.rect_rotation - a.rect_rotation, 2 * M_PI);
+        out.rect_rotation = a.rect_rotation + d * t;
+    }
+    else{
+        const HandFrame& nearest = b.has_rect ? b : a;
+        out.has_rect = nearest.has_rect;
+        out.rect_x_center = nearest.rect_x_center;
+        out.rect_y_center = nearest.rect_y_center;
+        out.rect_width = nearest.rect_width;
+        out.rect_height = nearest.rect_height;
+        out.rect_rotation = nearest.rect_rotation;
+    }
+}
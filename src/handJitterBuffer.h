@@ -0,0 +1,65 @@
+#pragma once
+#include "handFrame.h"
+
+/**
+ Small jitter buffer for incoming hand frames.
+ 
+ Frames are stored in order of their sender timestamp. Instead of showing the
+ newest frame, sample() renders the hand as it was `delay` microseconds ago,
+ interpolating between the two frames that bracket that time. When the buffer
+ runs dry (late or lost frames) the last motion is extrapolated for at most
+ `max_extrapolation` microseconds, then the last frame is held.
+ 
+ All times are passed in by the caller, so the buffer has no clock of its own.
+ */
+
+#define JITTER_BUFFER_SIZE 32
+
+class handJitterBuffer{
+
+    public:
+        struct Stats{
+            int64_t delay_usec = 0;             // current playout delay
+            int buffered = 0;                   // frames currently held
+            uint64_t frames_in = 0;
+            uint64_t frames_late = 0;           // arrived after their playout time
+            uint64_t underruns = 0;             // times the buffer ran dry
+            uint64_t extrapolated = 0;          // samples filled by extrapolation
+            uint64_t resets = 0;                // sender timestamp jumped backwards
+        };
+    
+        void setDelay(int64_t delay_usec);
+        void setMaxExtrapolation(int64_t usec);
+        void clear();
+    
+        // add a received frame; frame.receive_usec must be set
+        void push(const HandFrame& frame);
+    
+        // fill `out` with the hand at (now - delay); false if nothing is buffered yet
+        bool sample(int64_t now_usec, HandFrame& out);
+    
+        const Stats& getStats() const { return stats; }
+    
+    private:
+        void interpolate(const HandFrame& a, const HandFrame& b, float t, HandFrame& out) const;
+        int index(int i) const { return (head + i) % JITTER_BUFFER_SIZE; }
+    
+        HandFrame frames[JITTER_BUFFER_SIZE];
+        int head = 0;
+        int count = 0;
+    
+        // last frame retired from the buffer, used to extrapolate
+        HandFrame previous;
+        bool has_previous = false;
+    
+        // estimated (local clock - sender clock), tracked near its minimum
+        bool has_offset = false;
+        int64_t clock_offset = 0;
+    
+        int64_t delay = 66000;
+        int64_t max_extrapolation = 100000;
+        int64_t last_playout = 0;
+        bool was_underrun = false;
+    
+        Stats stats;
+};
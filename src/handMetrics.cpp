@@ -0,0 +1,269 @@
+#include "handMetrics.h"
+#include <cstdio>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+// exported bucket boundaries: 64 ns to about a minute; the rest only count
+// towards +Inf (and the ones below towards the first)
+#define METRIC_EXPORT_FIRST_BUCKET 11
+#define METRIC_EXPORT_LAST_BUCKET 71
+
+//--------------------------------------------------------------
+uint64_t metricHistogram::upperBound(int i){
+    if (i < 2)
+        return i + 1;
+    int msb = i / 2;
+    return (i & 1) ? (uint64_t)1 << (msb + 1) : (uint64_t)3 << (msb - 1);
+}
+
+//--------------------------------------------------------------
+uint64_t metricHistogram::getCount() const{
+    uint64_t count = 0;
+    for (const auto& bucket : buckets)
+        count += bucket.load(std::memory_order_relaxed);
+    return count;
+}
+
+//--------------------------------------------------------------
+handMetrics::~handMetrics(){
+    stop();
+}
+
+//--------------------------------------------------------------
+void handMetrics::add(metricCounter* counter, const std::string& name, const std::string& help, const std::string& labels){
+    add_entry(METRIC_COUNTER, counter, name + "_total", help, labels);
+}
+
+//--------------------------------------------------------------
+void handMetrics::add(metricGauge* gauge, const std::string& name, const std::string& help, const std::string& labels){
+    add_entry(METRIC_GAUGE, gauge, name, help, labels);
+}
+
+//--------------------------------------------------------------
+void handMetrics::add(metricHistogram* histogram, const std::string& name, const std::string& help, const std::string& labels){
+    add_entry(METRIC_HISTOGRAM, histogram, name + "_seconds", help, labels);
+}
+
+//--------------------------------------------------------------
+void handMetrics::add_entry(metricType type, const void* metric, const std::string& name, const std::string& help, const std::string& labels){
+    std::lock_guard<std::mutex> lock(mutex);
+    // keep metrics of one name together, as the format wants
+    auto it = entries.end();
+    for (auto e = entries.begin(); e != entries.end(); ++e){
+        if (e->name == name)
+            it = e + 1;
+    }
+    entries.insert(it, Entry{type, metric, name, help, labels});
+}
+
+//--------------------------------------------------------------
+static std::string label_set(const std::string& labels, const std::string& extra = ""){
+    if (labels.empty() && extra.empty())
+        return "";
+    if (labels.empty() || extra.empty())
+        return "{" + labels + extra + "}";
+    return "{" + labels + "," + extra + "}";
+}
+
+//--------------------------------------------------------------
+std::string handMetrics::render() const{
+
+    static const char* TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+    std::string out;
+    char line[256];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i=0; i<entries.size(); i++){
+        const Entry& e = entries[i];
+        if (i == 0 || entries[i - 1].name != e.name){
+            out += "# HELP " + e.name + " " + e.help + "\n";
+            out += "# TYPE " + e.name + " " + TYPE_NAMES[e.type] + "\n";
+        }
+
+        if (e.type == METRIC_COUNTER){
+            snprintf(line, sizeof(line), " %llu\n", (unsigned long long)((const metricCounter*)e.metric)->get());
+            out += e.name + label_set(e.labels) + line;
+        }
+        else if (e.type == METRIC_GAUGE){
+            snprintf(line, sizeof(line), " %lld\n", (long long)((const metricGauge*)e.metric)->get());
+            out += e.name + label_set(e.labels) + line;
+        }
+        else{
+            // cumulative counts, read once so the buckets add up to _count
+            const metricHistogram* histogram = (const metricHistogram*)e.metric;
+            uint64_t counts[METRIC_HISTOGRAM_BUCKETS];
+            for (int b=0; b<METRIC_HISTOGRAM_BUCKETS; b++)
+                counts[b] = histogram->getBucket(b);
+            std::string bucket_name = e.name + "_bucket";
+            uint64_t cumulative = 0;
+            for (int b=0; b<METRIC_HISTOGRAM_BUCKETS; b++){
+                cumulative += counts[b];
+                if (b < METRIC_EXPORT_FIRST_BUCKET || b > METRIC_EXPORT_LAST_BUCKET)
+                    continue;
+                snprintf(line, sizeof(line), "le=\"%.9g\"", metricHistogram::upperBound(b) / 1e9);
+                out += bucket_name + label_set(e.labels, line);
+                snprintf(line, sizeof(line), " %llu\n", (unsigned long long)cumulative);
+                out += line;
+            }
+            out += bucket_name + label_set(e.labels, "le=\"+Inf\"");
+            snprintf(line, sizeof(line), " %llu\n", (unsigned long long)cumulative);
+            out += line;
+            snprintf(line, sizeof(line), " %.9g\n", histogram->getSum() / 1e9);
+            out += e.name + "_sum" + label_set(e.labels) + line;
+            snprintf(line, sizeof(line), " %llu\n", (unsigned long long)cumulative);
+            out += e.name + "_count" + label_set(e.labels) + line;
+        }
+    }
+    return out;
+}
+
+//--------------------------------------------------------------
+bool handMetrics::write_file(){
+    std::string text = render();
+    std::string tmp = file_path + ".tmp";
+    FILE* file = fopen(tmp.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = fclose(file) == 0 && ok;
+#ifdef _WIN32
+    remove(file_path.c_str());
+#endif
+    return ok && rename(tmp.c_str(), file_path.c_str()) == 0;
+}
+
+//--------------------------------------------------------------
+bool handMetrics::serveFile(const std::string& path, double interval){
+    pause();
+    file_path = path;
+    file_interval = interval > 0 ? interval : 1;
+    bool ok = write_file();
+    if (!ok){
+        error = "can't write " + path;
+        file_path.clear();
+    }
+    start();
+    return ok;
+}
+
+//--------------------------------------------------------------
+bool handMetrics::serveSocket(const std::string& path){
+#ifdef _WIN32
+    error = "Unix domain sockets aren't supported here";
+    return false;
+#else
+    pause();
+    close_socket();
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)){
+        error = "socket path too long: " + path;
+        start();
+        return false;
+    }
+    strcpy(addr.sun_path, path.c_str());
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 8) != 0){
+        error = "metrics socket " + path + ": " + strerror(errno);
+        if (listen_fd >= 0)
+            ::close(listen_fd);
+        listen_fd = -1;
+        start();
+        return false;
+    }
+    socket_path = path;
+    start();
+    return true;
+#endif
+}
+
+//--------------------------------------------------------------
+void handMetrics::start(){
+    if (!exporter.joinable() && (!file_path.empty() || listen_fd >= 0)){
+        stopping = false;
+        exporter = std::thread(&handMetrics::run, this);
+    }
+}
+
+//--------------------------------------------------------------
+void handMetrics::pause(){
+    stopping = true;
+    if (exporter.joinable())
+        exporter.join();
+}
+
+//--------------------------------------------------------------
+void handMetrics::close_socket(){
+#ifndef _WIN32
+    if (listen_fd >= 0){
+        ::close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+#endif
+    listen_fd = -1;
+    socket_path.clear();
+}
+
+//--------------------------------------------------------------
+void handMetrics::stop(){
+    pause();
+    close_socket();
+    // leave the final numbers behind
+    if (!file_path.empty())
+        write_file();
+    file_path.clear();
+}
+
+//--------------------------------------------------------------
+void handMetrics::run(){
+
+    auto next_write = std::chrono::steady_clock::now();
+    while (!stopping){
+        auto now = std::chrono::steady_clock::now();
+        if (!file_path.empty() && now >= next_write){
+            write_file();
+            next_write = now + std::chrono::microseconds((int64_t)(file_interval * 1000000));
+        }
+
+#ifndef _WIN32
+        if (listen_fd >= 0){
+            // wake up at least every 100ms to notice stop()
+            struct pollfd p = {listen_fd, POLLIN, 0};
+            if (poll(&p, 1, 100) <= 0)
+                continue;
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+
+            // HTTP clients (curl --unix-socket) send a request first and
+            // get a response; anything else just gets the text
+            std::string text = render();
+            struct pollfd request = {fd, POLLIN, 0};
+            char buffer[1024];
+            if (poll(&request, 1, 20) > 0 && recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 3 && memcmp(buffer, "GET ", 4) == 0){
+                char header[160];
+                snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %zu\r\n\r\n", text.size());
+                text = header + text;
+            }
+            for (size_t sent = 0; sent < text.size(); ){
+                ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0)
+                    break;
+                sent += n;
+            }
+            ::close(fd);
+            continue;
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ Operational metrics for either end of the pipeline, in Prometheus text
+ format.
+
+ Counters, gauges and latency histograms are plain atomics: recording is a
+ few relaxed atomic adds, no locks and no allocation, so any thread can
+ record on the hot path. Histograms are HDR-style log-linear: two buckets
+ per power of two (1, 1.5, 2, 3, 4, 6, 8, ... ns), so every value lands in a
+ bucket within 50% of it across the whole range from nanoseconds to
+ minutes, in 128 fixed buckets.
+
+ A handMetrics registry names the metrics and renders them. It can rewrite
+ a stats file every second (written aside and renamed, so readers never
+ see half a file) and/or answer on a Unix domain socket: every connection
+ gets the current text, e.g. `curl --unix-socket /tmp/hands.sock http://x/`
+ or `socat - UNIX-CONNECT:/tmp/hands.sock`. Either way a node_exporter
+ textfile collector or a small proxy can feed it to Prometheus.
+
+ The metrics have to outlive the registry's export thread: stop() (or the
+ destructor) before destroying them.
+ */
+
+#define METRIC_HISTOGRAM_BUCKETS 128
+
+class metricCounter{
+
+    public:
+        void add(uint64_t n = 1){ value.fetch_add(n, std::memory_order_relaxed); }
+        uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> value{0};
+};
+
+class metricGauge{
+
+    public:
+        void set(int64_t v){ value.store(v, std::memory_order_relaxed); }
+        int64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int64_t> value{0};
+};
+
+class metricHistogram{
+
+    public:
+        // a duration in nanoseconds (exported in seconds)
+        void record(uint64_t ns){
+            buckets[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(ns, std::memory_order_relaxed);
+        }
+
+        // bucket i holds values below this, in nanoseconds
+        static uint64_t upperBound(int i);
+        static int bucket(uint64_t ns){
+            if (ns < 2)
+                return (int)ns;
+            int msb = 63 - clz(ns);
+            return 2 * msb + (int)((ns >> (msb - 1)) & 1);
+        }
+
+        uint64_t getCount() const;
+        uint64_t getSum() const { return sum.load(std::memory_order_relaxed); }
+        uint64_t getBucket(int i) const { return buckets[i].load(std::memory_order_relaxed); }
+
+    private:
+        static int clz(uint64_t v){
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, v);
+            return 63 - (int)index;
+#else
+            return __builtin_clzll(v);
+#endif
+        }
+
+        std::atomic<uint64_t> buckets[METRIC_HISTOGRAM_BUCKETS] = {};
+        std::atomic<uint64_t> sum{0};
+};
+
+// times the enclosing scope into a histogram
+class metricTimer{
+
+    public:
+        metricTimer(metricHistogram& histogram) : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+        ~metricTimer(){
+            histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+    private:
+        metricHistogram& histogram;
+        std::chrono::steady_clock::time_point start;
+};
+
+class handMetrics{
+
+    public:
+        ~handMetrics();
+
+        // name without suffixes (counters get _total, histograms _seconds);
+        // labels like `stage="draw"`, shared by all metrics of one name
+        void add(metricCounter* counter, const std::string& name, const std::string& help, const std::string& labels = "");
+        void add(metricGauge* gauge, const std::string& name, const std::string& help, const std::string& labels = "");
+        void add(metricHistogram* histogram, const std::string& name, const std::string& help, const std::string& labels = "");
+
+        // everything, in the Prometheus text exposition format
+        std::string render() const;
+
+        // rewrite `path` every `interval` seconds, from a background thread
+        bool serveFile(const std::string& path, double interval = 1);
+        // answer on a Unix domain socket at `path` (not on Windows); can be
+        // combined with serveFile()
+        bool serveSocket(const std::string& path);
+        // stop exporting (writing the file one last time), remove the socket
+        void stop();
+
+        const std::string& getError() const { return error; }
+
+    private:
+        enum metricType{ METRIC_COUNTER, METRIC_GAUGE, METRIC_HISTOGRAM };
+        struct Entry{
+            metricType type;
+            const void* metric;
+            std::string name;
+            std::string help;
+            std::string labels;
+        };
+
+        void add_entry(metricType type, const void* metric, const std::string& name, const std::string& help, const std::string& labels);
+        // the export thread reads the settings, so it's paused while they change
+        void start();
+        void pause();
+        void close_socket();
+        void run();
+        bool write_file();
+
+        mutable std::mutex mutex;           // guards entries
+        std::vector<Entry> entries;
+
+        std::thread exporter;
+        std::atomic<bool> stopping{false};
+        std::string file_path;
+        double file_interval = 1;
+        std::string socket_path;
+        int listen_fd = -1;
+        std::string error;
+};
@@ -0,0 +1,186 @@
+#include "handTrace.h"
+
+#ifdef HAND_TRACE
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/internal/json_objectwriter.h>
+
+struct traceSpan{
+    const char* name;
+    int64_t start_ns;
+    int64_t end_ns;
+};
+
+// one thread's spans. Only that thread writes; write() reads from another,
+// using head to tell which slots are complete.
+struct traceRing{
+    std::atomic<uint64_t> head{0};
+    traceSpan spans[HAND_TRACE_RING_SIZE];
+    int tid = 0;
+    std::string name;                   // guarded by the registry mutex
+};
+
+struct traceRegistry{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<traceRing>> rings;      // kept after their threads exit
+    std::string process_name;
+};
+
+//--------------------------------------------------------------
+static traceRegistry& registry(){
+    static traceRegistry instance;
+    return instance;
+}
+
+//--------------------------------------------------------------
+// the calling thread's ring, registered on first use
+static traceRing* thread_ring(){
+    static thread_local traceRing* ring = nullptr;
+    if (!ring){
+        traceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.rings.emplace_back(new traceRing());
+        ring = r.rings.back().get();
+        ring->tid = (int)r.rings.size();
+        ring->name = "thread " + std::to_string(ring->tid);
+    }
+    return ring;
+}
+
+//--------------------------------------------------------------
+void handTrace::record(const char* name, int64_t start_ns, int64_t end_ns){
+    traceRing* ring = thread_ring();
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    traceSpan& span = ring->spans[head & (HAND_TRACE_RING_SIZE - 1)];
+    span.name = name;
+    span.start_ns = start_ns;
+    span.end_ns = end_ns;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+void handTrace::setProcessName(const std::string& name){
+    traceRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.process_name = name;
+}
+
+//--------------------------------------------------------------
+void handTrace::setThreadName(const char* name){
+    traceRing* ring = thread_ring();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    ring->name = name;
+}
+
+//--------------------------------------------------------------
+bool handTrace::isEnabled(){
+    return true;
+}
+
+//--------------------------------------------------------------
+static void write_metadata(::google::protobuf::util::converter::JsonObjectWriter& writer, const char* what, int pid, int tid, const std::string& name){
+    writer.StartObject("");
+    writer.RenderString("name", what);
+    writer.RenderString("ph", "M");
+    writer.RenderUint32("pid", pid);
+    writer.RenderUint32("tid", tid);
+    writer.StartObject("args");
+    writer.RenderString("name", name);
+    writer.EndObject();
+    writer.EndObject();
+}
+
+//--------------------------------------------------------------
+bool handTrace::write(const std::string& path){
+
+    int pid = getpid();
+    std::string json;
+    {
+        ::google::protobuf::io::StringOutputStream stream(&json);
+        ::google::protobuf::io::CodedOutputStream coded(&stream);
+        ::google::protobuf::util::converter::JsonObjectWriter writer("", &coded);
+        writer.StartObject("");
+        writer.RenderString("displayTimeUnit", "ns");
+        writer.StartList("traceEvents");
+
+        traceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        write_metadata(writer, "process_name", pid, 0, r.process_name.empty() ? "hand tracking" : r.process_name);
+
+        std::vector<traceSpan> spans;
+        for (auto& ring : r.rings){
+            write_metadata(writer, "thread_name", pid, ring->tid, ring->name);
+
+            // copy the newest spans, then drop any the thread overwrote
+            // while we were copying. The slot at `after` is being written
+            // right now (record() fills it before publishing head), and once
+            // the ring has wrapped that's the oldest one we copied.
+            uint64_t end = ring->head.load(std::memory_order_acquire);
+            uint64_t begin = end > HAND_TRACE_RING_SIZE ? end - HAND_TRACE_RING_SIZE : 0;
+            spans.clear();
+            for (uint64_t i=begin; i<end; i++)
+                spans.push_back(ring->spans[i & (HAND_TRACE_RING_SIZE - 1)]);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t after = ring->head.load(std::memory_order_relaxed);
+            uint64_t valid = after + 1 > HAND_TRACE_RING_SIZE ? after + 1 - HAND_TRACE_RING_SIZE : 0;
+
+            for (uint64_t i=std::max(begin, valid); i<end; i++){
+                const traceSpan& span = spans[i - begin];
+                writer.StartObject("");
+                writer.RenderString("name", span.name);
+                writer.RenderString("ph", "X");
+                writer.RenderDouble("ts", span.start_ns / 1000.0);
+                writer.RenderDouble("dur", (span.end_ns - span.start_ns) / 1000.0);
+                writer.RenderUint32("pid", pid);
+                writer.RenderUint32("tid", ring->tid);
+                writer.EndObject();
+            }
+        }
+        writer.EndList();
+        writer.EndObject();
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = fwrite(json.data(), 1, json.size(), file) == json.size();
+    return fclose(file) == 0 && ok;
+}
+
+#else
+
+//--------------------------------------------------------------
+void handTrace::record(const char*, int64_t, int64_t){
+}
+
+//--------------------------------------------------------------
+void handTrace::setProcessName(const std::string&){
+}
+
+//--------------------------------------------------------------
+void handTrace::setThreadName(const char*){
+}
+
+//--------------------------------------------------------------
+bool handTrace::isEnabled(){
+    return false;
+}
+
+//--------------------------------------------------------------
+bool handTrace::write(const std::string&){
+    return false;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ Low-overhead span tracing for the hot paths, written out as Chrome
+ trace-event JSON (load it in chrome://tracing or ui.perfetto.dev).
+
+ Only compiled in with -DHAND_TRACE; otherwise the HAND_TRACE_* macros are
+ empty and cost nothing. When on, each thread records into its own fixed
+ ring of spans (the newest HAND_TRACE_RING_SIZE are kept): recording a span
+ is two clock reads and a few stores, with no locks and no allocation.
+ write() collects every thread's ring into one JSON file.
+
+ Timestamps come from the monotonic clock, which all processes on a host
+ share, so a sender trace and a receiver trace line up when loaded
+ together (see the README).
+
+   void ofApp::update(){
+       HAND_TRACE_SCOPE("update");     // a span from here to the end of the block
+       ...
+   }
+
+ Span names must be string literals (only the pointer is stored).
+ */
+
+#ifndef HAND_TRACE_RING_SIZE
+#define HAND_TRACE_RING_SIZE (1 << 15)      // spans kept per thread, a power of two
+#endif
+
+class handTrace{
+
+    public:
+        // shown as the process and thread names in the trace viewer
+        static void setProcessName(const std::string& name);
+        static void setThreadName(const char* name);
+
+        // every thread's recorded spans, as Chrome trace JSON; false (and
+        // nothing written) if tracing isn't compiled in
+        static bool write(const std::string& path);
+        static bool isEnabled();
+
+        static inline int64_t now_ns(){
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // adds a finished span to the calling thread's ring
+        static void record(const char* name, int64_t start_ns, int64_t end_ns);
+};
+
+// times the enclosing scope
+class handTraceScope{
+
+    public:
+        handTraceScope(const char* name) : name(name), start_ns(handTrace::now_ns()) {}
+        ~handTraceScope(){ handTrace::record(name, start_ns, handTrace::now_ns()); }
+
+    private:
+        const char* name;
+        int64_t start_ns;
+};
+
+#ifdef HAND_TRACE
+#define HAND_TRACE_CONCAT_(a, b) a##b
+#define HAND_TRACE_CONCAT(a, b) HAND_TRACE_CONCAT_(a, b)
+#define HAND_TRACE_SCOPE(name) handTraceScope HAND_TRACE_CONCAT(hand_trace_scope_, __LINE__)(name)
+#define HAND_TRACE_THREAD(name) handTrace::setThreadName(name)
+#else
+#define HAND_TRACE_SCOPE(name)
+#define HAND_TRACE_THREAD(name)
+#endif
@@ -0,0 +1,190 @@
+#include "handWire.h"
+#include <cmath>
+#include <cstring>
+
+// after the 0xff marker
+#define HAND_WIRE_RAW_TAG 'R'
+#define HAND_WIRE_QUANTIZED_TAG 'Q'
+
+#define HAND_WIRE_FLAG_SEQUENCE 1
+#define HAND_WIRE_FLAG_RECT 2
+
+// shared header: marker, tag, flags, landmark count, then sequence id,
+// timestamp and send time. Multi-byte fields are copied as they are in
+// memory, which is little-endian on every host we build for.
+#define HAND_WIRE_HEADER_SIZE 28
+
+//--------------------------------------------------------------
+const char* hand_wire_name(handWireFormat format){
+    switch (format){
+        case HAND_WIRE_RAW:         return "raw";
+        case HAND_WIRE_QUANTIZED:   return "quantized";
+        default:                    return "protobuf";
+    }
+}
+
+//--------------------------------------------------------------
+handWireFormat hand_wire_format(const char* data, int size){
+    if (size >= 2 && (uint8_t)data[0] == 0xff){
+        if (data[1] == HAND_WIRE_RAW_TAG)
+            return HAND_WIRE_RAW;
+        if (data[1] == HAND_WIRE_QUANTIZED_TAG)
+            return HAND_WIRE_QUANTIZED;
+    }
+    return HAND_WIRE_PROTOBUF;
+}
+
+//--------------------------------------------------------------
+static inline uint16_t quantize(float v){
+    // clamped to >= 0 first, so adding a half and truncating rounds
+    float q = (v + 0.5f) * 32768.0f + 0.5f;
+    q = q < 0 ? 0 : q > 65535 ? 65535 : q;
+    return (uint16_t)q;
+}
+
+//--------------------------------------------------------------
+static inline float dequantize(uint16_t q){
+    return q / 32768.0f - 0.5f;
+}
+
+//--------------------------------------------------------------
+static inline int16_t quantize_signed(float v, float scale){
+    float q = v * scale;
+    q = q < -32768 ? -32768 : q > 32767 ? 32767 : q;
+    return (int16_t)floorf(q + 0.5f);
+}
+
+//--------------------------------------------------------------
+static char* write_header(char* p, char tag, const HandFrame& frame){
+    *p++ = (char)0xff;
+    *p++ = tag;
+    *p++ = (frame.has_sequence ? HAND_WIRE_FLAG_SEQUENCE : 0) | (frame.has_rect ? HAND_WIRE_FLAG_RECT : 0);
+    *p++ = (char)frame.num_landmarks;
+    memcpy(p, &frame.sequence_id, 8);
+    memcpy(p + 8, &frame.timestamp_usec, 8);
+    memcpy(p + 16, &frame.send_time_usec, 8);
+    return p + 24;
+}
+
+//--------------------------------------------------------------
+static const char* read_header(const char* p, HandFrame& frame){
+    uint8_t flags = p[2];
+    frame.num_landmarks = (uint8_t)p[3];
+    frame.has_sequence = flags & HAND_WIRE_FLAG_SEQUENCE;
+    frame.has_rect = flags & HAND_WIRE_FLAG_RECT;
+    memcpy(&frame.sequence_id, p + 4, 8);
+    memcpy(&frame.timestamp_usec, p + 12, 8);
+    memcpy(&frame.send_time_usec, p + 20, 8);
+    return p + HAND_WIRE_HEADER_SIZE;
+}
+
+//--------------------------------------------------------------
+int encode_hand_frame(handWireFormat format, const HandFrame& frame, char* data, int size, ::mediapipe::WrapperHandTracking& wrapper){
+
+    int n = frame.num_landmarks;
+    if (format == HAND_WIRE_RAW){
+        int total = HAND_WIRE_HEADER_SIZE + n * 12 + 20;
+        if (total > size)
+            return 0;
+        char* p = write_header(data, HAND_WIRE_RAW_TAG, frame);
+        memcpy(p, frame.x, n * 4);
+        memcpy(p + n * 4, frame.y, n * 4);
+        memcpy(p + n * 8, frame.z, n * 4);
+        float rect[5] = {frame.rect_x_center, frame.rect_y_center, frame.rect_width, frame.rect_height, frame.rect_rotation};
+        memcpy(p + n * 12, rect, sizeof(rect));
+        return total;
+    }
+
+    if (format == HAND_WIRE_QUANTIZED){
+        int total = HAND_WIRE_HEADER_SIZE + n * 6 + 10;
+        if (total > size)
+            return 0;
+        char* p = write_header(data, HAND_WIRE_QUANTIZED_TAG, frame);
+        uint16_t q[NUM_HAND_LANDMARKS * 3 + 5];
+        for (int i=0; i<n; i++){
+            q[i] = quantize(frame.x[i]);
+            q[n + i] = quantize(frame.y[i]);
+            q[2 * n + i] = (uint16_t)quantize_signed(frame.z[i], 65536.0f);
+        }
+        q[3 * n] = quantize(frame.rect_x_center);
+        q[3 * n + 1] = quantize(frame.rect_y_center);
+        q[3 * n + 2] = quantize(frame.rect_width);
+        q[3 * n + 3] = quantize(frame.rect_height);
+        q[3 * n + 4] = (uint16_t)quantize_signed(frame.rect_rotation, 10000.0f);
+        memcpy(p, q, (3 * n + 5) * 2);
+        return total;
+    }
+
+    // the same fields MyPassThroughCalculator fills in
+    wrapper.Clear();
+    wrapper.set_timestamp_usec(frame.timestamp_usec);
+    for (int i=0; i<n; i++){
+        auto* landmark = wrapper.mutable_landmarks()->add_landmark();
+        landmark->set_x(frame.x[i]);
+        landmark->set_y(frame.y[i]);
+        landmark->set_z(frame.z[i]);
+    }
+    if (frame.has_rect){
+        auto* rect = wrapper.mutable_rect();
+        rect->set_x_center(frame.rect_x_center);
+        rect->set_y_center(frame.rect_y_center);
+        rect->set_width(frame.rect_width);
+        rect->set_height(frame.rect_height);
+        rect->set_rotation(frame.rect_rotation);
+    }
+    if (frame.has_sequence)
+        wrapper.set_sequence_id(frame.sequence_id);
+    if (frame.send_time_usec)
+        wrapper.set_send_time_usec(frame.send_time_usec);
+    int total = wrapper.ByteSizeLong();
+    if (total > size || !wrapper.SerializeToArray(data, total))
+        return 0;
+    return total;
+}
+
+//--------------------------------------------------------------
+bool decode_hand_frame_any(const char* data, int size, ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame){
+
+    handWireFormat format = hand_wire_format(data, size);
+    if (format == HAND_WIRE_PROTOBUF)
+        return decode_hand_frame(data, size, wrapper, frame);
+    if (size < HAND_WIRE_HEADER_SIZE)
+        return false;
+
+    const char* p = read_header(data, frame);
+    int n = frame.num_landmarks;
+    if (n > NUM_HAND_LANDMARKS)
+        return false;
+
+    if (format == HAND_WIRE_RAW){
+        if (size < HAND_WIRE_HEADER_SIZE + n * 12 + 20)
+            return false;
+        memcpy(frame.x, p, n * 4);
+        memcpy(frame.y, p + n * 4, n * 4);
+        memcpy(frame.z, p + n * 8, n * 4);
+        float rect[5];
+        memcpy(rect, p + n * 12, sizeof(rect));
+        frame.rect_x_center = rect[0];
+        frame.rect_y_center = rect[1];
+        frame.rect_width = rect[2];
+        frame.rect_height = rect[3];
+        frame.rect_rotation = rect[4];
+        return true;
+    }
+
+    if (size < HAND_WIRE_HEADER_SIZE + n * 6 + 10)
+        return false;
+    uint16_t q[NUM_HAND_LANDMARKS * 3 + 5];
+    memcpy(q, p, (3 * n + 5) * 2);
+    for (int i=0; i<n; i++){
+        frame.x[i] = dequantize(q[i]);
+        frame.y[i] = dequantize(q[n + i]);
+        frame.z[i] = (int16_t)q[2 * n + i] / 65536.0f;
+    }
+    frame.rect_x_center = dequantize(q[3 * n]);
+    frame.rect_y_center = dequantize(q[3 * n + 1]);
+    frame.rect_width = dequantize(q[3 * n + 2]);
+    frame.rect_height = dequantize(q[3 * n + 3]);
+    frame.rect_rotation = (int16_t)q[3 * n + 4] / 10000.0f;
+    return true;
+}
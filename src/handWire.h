@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include "handFrame.h"
+
+/**
+ Alternative wire formats for one hand frame, next to the protobuf wrapper.
+
+ HAND_WIRE_RAW is the HandFrame fields in a fixed little-endian layout:
+ no parsing, just copies. HAND_WIRE_QUANTIZED stores the landmarks as 16
+ bit fixed point over [-0.5, 1.5) (about 3e-5 of the image, a fiftieth of a
+ pixel at 640 wide), about half the size of the others. Both start with a
+ 0xff byte, which can't begin our protobuf messages (all their field tags
+ are single bytes), so a receiver can tell the three apart.
+ */
+
+enum handWireFormat{
+    HAND_WIRE_PROTOBUF = 0,
+    HAND_WIRE_RAW,
+    HAND_WIRE_QUANTIZED
+};
+
+#define HAND_WIRE_MAX_SIZE 512
+
+const char* hand_wire_name(handWireFormat format);
+
+// which format a datagram is in
+handWireFormat hand_wire_format(const char* data, int size);
+
+// returns the encoded size, or 0 if `size` is too small. The wrapper is
+// scratch space for the protobuf format.
+int encode_hand_frame(handWireFormat format, const HandFrame& frame, char* data, int size, ::mediapipe::WrapperHandTracking& wrapper);
+
+// any of the formats, told apart by their first byte
+bool decode_hand_frame_any(const char* data, int size, ::mediapipe::WrapperHandTracking& wrapper, HandFrame& frame);
@@ -0,0 +1,360 @@
+#include "indexedCapture.h"
+#include <algorithm>
+#include <cstring>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/util/delimited_message_util.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+static const char MAGIC[8] = {'H', 'A', 'N', 'D', 'C', 'A', 'P', 'X'};
+static const uint32_t VERSION = 1;
+static const size_t HEADER_SIZE = 16;
+static const size_t INDEX_ENTRY_SIZE = 24;
+static const size_t FOOTER_SIZE = 24;
+
+// HandTrackingCaptureRecord's fields on the wire: field number << 3 | wire type
+static const uint32_t TAG_RECEIVE_USEC = 1 << 3 | WireFormatLite::WIRETYPE_VARINT;
+static const uint32_t TAG_SOURCE = 2 << 3 | WireFormatLite::WIRETYPE_VARINT;
+static const uint32_t TAG_FRAME = 3 << 3 | WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+static const uint32_t TAG_RECEIVE_WALL_USEC = 4 << 3 | WireFormatLite::WIRETYPE_VARINT;
+
+//--------------------------------------------------------------
+static void put_le(std::string& out, uint64_t value, int bytes){
+    for (int i=0; i<bytes; i++)
+        out.push_back((char)(value >> (8 * i)));
+}
+
+//--------------------------------------------------------------
+static uint64_t get_le(const char* in, int bytes){
+    uint64_t value = 0;
+    for (int i=0; i<bytes; i++)
+        value |= (uint64_t)(uint8_t)in[i] << (8 * i);
+    return value;
+}
+
+//--------------------------------------------------------------
+indexedCaptureWriter::~indexedCaptureWriter(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureWriter::open(const std::string& path, int records_per_chunk){
+
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (!file){
+        error = "can't create " + path;
+        return false;
+    }
+    this->records_per_chunk = std::max(1, records_per_chunk);
+    std::string header(MAGIC, sizeof(MAGIC));
+    put_le(header, VERSION, 4);
+    put_le(header, 0, 4);
+    fwrite(header.data(), 1, header.size(), file);
+    offset = header.size();
+    num_records = 0;
+    chunk.clear();
+    current.num_records = 0;
+    index.clear();
+    error.clear();
+    return true;
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureWriter::write(const ::mediapipe::HandTrackingCaptureRecord& record){
+
+    if (!file)
+        return false;
+
+    if (current.num_records == 0){
+        current.first_receive_usec = record.receive_usec();
+        current.offset = offset;
+    }
+    {
+        google::protobuf::io::StringOutputStream out(&chunk);
+        google::protobuf::util::SerializeDelimitedToZeroCopyStream(record, &out);
+    }
+    current.num_records++;
+    num_records++;
+
+    if ((int)current.num_records >= records_per_chunk)
+        return flush_chunk();
+    return true;
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureWriter::flush_chunk(){
+
+    if (current.num_records == 0)
+        return true;
+    current.size = chunk.size();
+    if (fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size()){
+        error = "write failed";
+        return false;
+    }
+    index.push_back(current);
+    offset += chunk.size();
+    chunk.clear();
+    current.num_records = 0;
+    return true;
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureWriter::close(){
+
+    if (!file)
+        return false;
+
+    bool ok = flush_chunk();
+    std::string footer;
+    for (auto& entry : index){
+        put_le(footer, entry.first_receive_usec, 8);
+        put_le(footer, entry.offset, 8);
+        put_le(footer, entry.size, 4);
+        put_le(footer, entry.num_records, 4);
+    }
+    put_le(footer, offset, 8);
+    put_le(footer, index.size(), 8);
+    footer.append(MAGIC, sizeof(MAGIC));
+    ok = ok && fwrite(footer.data(), 1, footer.size(), file) == footer.size();
+    ok = fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok && error.empty())
+        error = "write failed";
+    return ok;
+}
+
+//--------------------------------------------------------------
+indexedCaptureReader::~indexedCaptureReader(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureReader::open(const std::string& path){
+
+    close();
+    error.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE){
+        error = "can't open " + path;
+        return false;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    file_handle = file;
+    mapping_handle = mapping;
+    if (!view){
+        error = "can't map " + path;
+        close();
+        return false;
+    }
+    data = (const char*)view;
+    length = size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0){
+        error = "can't open " + path;
+        return false;
+    }
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED){
+        error = "can't map " + path;
+        return false;
+    }
+    data = (const char*)view;
+    length = st.st_size;
+#endif
+
+    // check the header and footer, then load the index
+    if (length < HEADER_SIZE + FOOTER_SIZE ||
+        memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        memcmp(data + length - sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0){
+        error = path + " isn't an indexed capture";
+        close();
+        return false;
+    }
+    const char* footer = data + length - FOOTER_SIZE;
+    uint64_t index_offset = get_le(footer, 8);
+    uint64_t num_chunks = get_le(footer + 8, 8);
+    if (get_le(data + 8, 4) != VERSION ||
+        index_offset < HEADER_SIZE ||
+        num_chunks > (length - FOOTER_SIZE - index_offset) / INDEX_ENTRY_SIZE ||
+        index_offset + num_chunks * INDEX_ENTRY_SIZE + FOOTER_SIZE != length){
+        error = path + ": damaged index";
+        close();
+        return false;
+    }
+
+    index.resize(num_chunks);
+    num_records = 0;
+    for (uint64_t i=0; i<num_chunks; i++){
+        const char* entry = data + index_offset + i * INDEX_ENTRY_SIZE;
+        Chunk& c = index[i];
+        c.first_receive_usec = (int64_t)get_le(entry, 8);
+        c.offset = get_le(entry + 8, 8);
+        c.size = get_le(entry + 16, 4);
+        c.num_records = get_le(entry + 20, 4);
+        if (c.offset < HEADER_SIZE || c.offset + c.size > index_offset){
+            error = path + ": damaged index";
+            close();
+            return false;
+        }
+        num_records += c.num_records;
+    }
+    rewind();
+    return true;
+}
+
+//--------------------------------------------------------------
+void indexedCaptureReader::close(){
+
+#ifdef _WIN32
+    if (data)
+        UnmapViewOfFile(data);
+    if (mapping_handle)
+        CloseHandle(mapping_handle);
+    if (file_handle)
+        CloseHandle(file_handle);
+    mapping_handle = file_handle = nullptr;
+#else
+    if (data)
+        munmap((void*)data, length);
+#endif
+    data = nullptr;
+    length = 0;
+    index.clear();
+    num_records = 0;
+    rewind();
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureReader::next_record(const char*& record, int& size){
+
+    while (chunk < (int)index.size()){
+        const Chunk& c = index[chunk];
+        if (position >= c.size){
+            chunk++;
+            position = 0;
+            continue;
+        }
+
+        // varint length, then the record
+        const uint8_t* start = (const uint8_t*)data + c.offset + position;
+        int remaining = c.size - position;
+        CodedInputStream in(start, remaining);
+        uint32_t record_size;
+        if (!in.ReadVarint32(&record_size) || record_size > (uint32_t)(remaining - in.CurrentPosition())){
+            error = "damaged record";
+            chunk = index.size();
+            return false;
+        }
+        record = (const char*)start + in.CurrentPosition();
+        size = record_size;
+        position += in.CurrentPosition() + record_size;
+        return true;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureReader::read(::mediapipe::HandTrackingCaptureRecord& record){
+
+    const char* bytes;
+    int size;
+    if (!next_record(bytes, size))
+        return false;
+    if (!record.ParseFromArray(bytes, size)){
+        error = "damaged record";
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+bool indexedCaptureReader::readRaw(RawRecord& record){
+
+    const char* bytes;
+    int size;
+    if (!next_record(bytes, size))
+        return false;
+
+    // pick the fields out by hand, leaving the frame where it is
+    record = RawRecord();
+    CodedInputStream in((const uint8_t*)bytes, size);
+    uint32_t tag;
+    while ((tag = in.ReadTag()) != 0){
+        uint64_t value;
+        uint32_t frame_size;
+        switch (tag){
+            case TAG_RECEIVE_USEC:
+                if (!in.ReadVarint64(&value))
+                    return false;
+                record.receive_usec = (int64_t)value;
+                break;
+            case TAG_SOURCE:
+                if (!in.ReadVarint64(&value))
+                    return false;
+                record.source = (int)(int64_t)value;
+                break;
+            case TAG_FRAME:
+                if (!in.ReadVarint32(&frame_size) || frame_size > (uint32_t)(size - in.CurrentPosition()))
+                    return false;
+                record.frame = bytes + in.CurrentPosition();
+                record.frame_size = frame_size;
+                in.Skip(frame_size);
+                break;
+            case TAG_RECEIVE_WALL_USEC:
+                if (!in.ReadVarint64(&value))
+                    return false;
+                record.receive_wall_usec = (int64_t)value;
+                break;
+            default:
+                if (!WireFormatLite::SkipField(&in, tag))
+                    return false;
+                break;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void indexedCaptureReader::seek(int64_t receive_usec){
+
+    // the last chunk starting at or before receive_usec...
+    auto it = std::upper_bound(index.begin(), index.end(), receive_usec,
+                               [](int64_t t, const Chunk& c){ return t < c.first_receive_usec; });
+    chunk = std::max<int>(0, (int)(it - index.begin()) - 1);
+    position = 0;
+
+    // ...then the first record in it (or the next) that isn't earlier
+    RawRecord record;
+    while (true){
+        int at_chunk = chunk;
+        uint32_t at_position = position;
+        if (!readRaw(record) || record.receive_usec >= receive_usec){
+            chunk = at_chunk;
+            position = at_position;
+            return;
+        }
+    }
+}
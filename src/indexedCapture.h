@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "wrapper_hand_tracking.pb.h"
+
+/**
+ Capture file with an index, for seeking in long sessions.
+
+ The records are the same length-delimited HandTrackingCaptureRecords as a
+ plain capture (see handCapture.h), uncompressed and grouped into chunks of
+ up to records_per_chunk. A footer indexes every chunk by the receive time
+ of its first record:
+
+   "HANDCAPX" version(u32) 0(u32)
+   chunk 0 records ... chunk n-1 records
+   index: n x { first_receive_usec(i64) offset(u64) size(u32) records(u32) }
+   index_offset(u64) n(u64) "HANDCAPX"
+
+ All integers are little-endian. The reader maps the whole file and parses
+ straight out of the mapping through an ArrayInputStream, so seeking is a
+ binary search over the chunks plus a short scan inside one, and replay
+ reads no file data it doesn't hand back. readRaw() goes one step further
+ and returns the WrapperHandTracking bytes in place, for re-sending them
+ without a parse.
+ */
+
+class indexedCaptureWriter{
+
+    public:
+        ~indexedCaptureWriter();
+
+        bool open(const std::string& path, int records_per_chunk = 256);
+        // writes the last chunk and the index; the file is unreadable until then
+        bool close();
+        bool isOpen() const { return file != nullptr; }
+
+        bool write(const ::mediapipe::HandTrackingCaptureRecord& record);
+
+        uint64_t getNumRecords() const { return num_records; }
+        const std::string& getError() const { return error; }
+
+    private:
+        struct Chunk{
+            int64_t first_receive_usec;
+            uint64_t offset;
+            uint32_t size;
+            uint32_t num_records;
+        };
+
+        bool flush_chunk();
+
+        FILE* file = nullptr;
+        int records_per_chunk = 256;
+        uint64_t offset = 0;
+        uint64_t num_records = 0;
+        std::string chunk;              // the records of the chunk being filled
+        Chunk current;
+        std::vector<Chunk> index;
+        std::string error;
+};
+
+class indexedCaptureReader{
+
+    public:
+        ~indexedCaptureReader();
+
+        // false if `path` isn't an indexed capture (getError() says why)
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return data != nullptr; }
+
+        uint64_t getNumRecords() const { return num_records; }
+        int getNumChunks() const { return (int)index.size(); }
+        int64_t getStartUsec() const { return index.empty() ? 0 : index.front().first_receive_usec; }
+
+        // positions on the first record received at or after receive_usec
+        void seek(int64_t receive_usec);
+        void rewind() { chunk = 0; position = 0; }
+
+        bool read(::mediapipe::HandTrackingCaptureRecord& record);
+
+        // the next record without parsing the frame: `frame` points into the
+        // mapping and stays valid until close()
+        struct RawRecord{
+            int64_t receive_usec = 0;
+            int64_t receive_wall_usec = 0;
+            int source = 0;
+            const char* frame = nullptr;
+            int frame_size = 0;
+        };
+        bool readRaw(RawRecord& record);
+
+        const std::string& getError() const { return error; }
+
+    private:
+        struct Chunk{
+            int64_t first_receive_usec;
+            uint64_t offset;
+            uint32_t size;
+            uint32_t num_records;
+        };
+
+        // the next record's bytes in the current chunk, moving on to the
+        // next chunk at the end of one
+        bool next_record(const char*& record, int& size);
+
+        const char* data = nullptr;
+        size_t length = 0;
+#ifdef _WIN32
+        void* file_handle = nullptr;
+        void* mapping_handle = nullptr;
+#endif
+        std::vector<Chunk> index;
+        uint64_t num_records = 0;
+        int chunk = 0;                  // where read() continues
+        uint32_t position = 0;          // bytes into the chunk
+        std::string error;
+};
@@ -0,0 +1,60 @@
+#include "labelAtlas.h"
+
+//--------------------------------------------------------------
+void labelAtlas::setup(const vector<string>& labels){
+
+    // one label per row
+    int width = 0;
+    widths.clear();
+    for (auto& label : labels){
+        widths.push_back(label.size() * LABEL_ATLAS_CHAR_WIDTH);
+        width = max(width, widths.back());
+    }
+    if (labels.empty())
+        return;
+
+    atlas.allocate(width, labels.size() * LABEL_ATLAS_ROW_HEIGHT, GL_RGBA);
+    atlas.begin();
+    ofClear(255, 255, 255, 0);
+    ofPushStyle();
+    ofSetColor(255);
+    for (int i=0; i<labels.size(); i++)
+        ofDrawBitmapString(labels[i], 0, i * LABEL_ATLAS_ROW_HEIGHT + LABEL_ATLAS_BASELINE);
+    ofPopStyle();
+    atlas.end();
+
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+    mesh.setUsage(GL_STREAM_DRAW);
+}
+
+//--------------------------------------------------------------
+void labelAtlas::add(int index, float x, float y){
+
+    if (index < 0 || index >= size())
+        return;
+
+    ofTexture& tex = atlas.getTexture();
+    float w = widths[index];
+    float h = LABEL_ATLAS_ROW_HEIGHT;
+    float row = index * h;
+
+    // two triangles, texture coordinates in whatever space the texture uses
+    auto t0 = tex.getCoordFromPoint(0, row);
+    auto t1 = tex.getCoordFromPoint(w, row + h);
+    mesh.addVertex(ofVec3f(x, y));          mesh.addTexCoord(ofVec2f(t0.x, t0.y));
+    mesh.addVertex(ofVec3f(x + w, y));      mesh.addTexCoord(ofVec2f(t1.x, t0.y));
+    mesh.addVertex(ofVec3f(x + w, y + h));  mesh.addTexCoord(ofVec2f(t1.x, t1.y));
+    mesh.addVertex(ofVec3f(x, y));          mesh.addTexCoord(ofVec2f(t0.x, t0.y));
+    mesh.addVertex(ofVec3f(x + w, y + h));  mesh.addTexCoord(ofVec2f(t1.x, t1.y));
+    mesh.addVertex(ofVec3f(x, y + h));      mesh.addTexCoord(ofVec2f(t0.x, t1.y));
+}
+
+//--------------------------------------------------------------
+void labelAtlas::draw(){
+
+    if (mesh.getNumVertices() == 0)
+        return;
+    atlas.getTexture().bind();
+    mesh.draw();
+    atlas.getTexture().unbind();
+}
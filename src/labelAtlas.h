@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ A fixed set of short labels (e.g. landmark numbers), rendered once with the
+ bitmap font into one texture.
+
+ Each frame, add() appends a textured quad per label to one mesh and draw()
+ draws them all at once, instead of one ofDrawBitmapString (which rebuilds
+ the glyph quads every call) per label. The text is white in the atlas, so
+ ofSetColor tints it.
+ */
+
+class labelAtlas{
+
+    public:
+        void setup(const vector<string>& labels);
+
+        // places label `index` with the top left of its bitmap string at (x, y)
+        void add(int index, float x, float y);
+        void draw();
+        void clear() { mesh.clear(); }
+
+        int size() const { return (int)widths.size(); }
+
+    private:
+        ofFbo atlas;
+        ofVboMesh mesh;
+        vector<int> widths;         // in pixels, per label
+};
+
+// bitmap font cell size, and where the baseline sits in it
+#define LABEL_ATLAS_CHAR_WIDTH 8
+#define LABEL_ATLAS_ROW_HEIGHT 16
+#define LABEL_ATLAS_BASELINE 12
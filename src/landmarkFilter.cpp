@@ -0,0 +1,133 @@
+#include "landmarkFilter.h"
+#include <cmath>
+
+// gaps longer than this (hand lost and found again) restart the filter
+#define LANDMARK_FILTER_MAX_GAP_USEC 500000
+
+//--------------------------------------------------------------
+void landmarkFilter::setMode(landmarkFilterMode newMode){
+    mode = newMode;
+    reset();
+}
+
+//--------------------------------------------------------------
+void landmarkFilter::setOneEuro(float min_cutoff, float beta, float d_cutoff){
+    this->min_cutoff = min_cutoff;
+    this->beta = beta;
+    this->d_cutoff = d_cutoff;
+}
+
+//--------------------------------------------------------------
+void landmarkFilter::setKalman(float process_noise, float measurement_noise){
+    this->process_noise = process_noise;
+    this->measurement_noise = measurement_noise;
+}
+
+//--------------------------------------------------------------
+void landmarkFilter::reset(){
+    primed = false;
+}
+
+//--------------------------------------------------------------
+bool landmarkFilter::apply(HandFrame& frame){
+    
+    if (mode == LANDMARK_FILTER_NONE || frame.num_landmarks == 0)
+        return true;
+    
+    int64_t gap = frame.timestamp_usec - last_timestamp;
+    
+    // a late (reordered) frame is dropped and leaves the state alone; a long
+    // jump back means the sender restarted
+    if (primed && gap <= 0 && gap >= -LANDMARK_FILTER_MAX_GAP_USEC)
+        return false;
+    if (primed && (gap <= 0 || gap > LANDMARK_FILTER_MAX_GAP_USEC || frame.num_landmarks != num_landmarks))
+        primed = false;
+    last_timestamp = frame.timestamp_usec;
+    num_landmarks = frame.num_landmarks;
+    
+    float* axes[3] = {frame.x, frame.y, frame.z};
+    
+    // first frame: take the measurement as is
+    if (!primed){
+        for (int a=0; a<3; a++){
+            for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+                float v = i < num_landmarks ? axes[a][i] : 0;
+                value[a][i] = v;
+                deriv[a][i] = 0;
+                pos[a][i] = v;
+                vel[a][i] = 0;
+                p00[a][i] = measurement_noise;
+                p01[a][i] = 0;
+                p11[a][i] = process_noise;
+            }
+        }
+        primed = true;
+        return true;
+    }
+    
+    float dt = gap * 0.000001f;
+    for (int a=0; a<3; a++){
+        if (mode == LANDMARK_FILTER_ONE_EURO)
+            one_euro(axes[a], a, dt);
+        else
+            kalman(axes[a], a, dt);
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void landmarkFilter::one_euro(float* v, int axis, float dt){
+    
+    // smoothing factor of a first order low-pass with the given cutoff
+    //   alpha = 1 / (1 + tau/dt),  tau = 1 / (2*pi*cutoff)
+    const float inv_2pi_dt = 1.0f / (2.0f * (float)M_PI * dt);
+    const float alpha_d = 1.0f / (1.0f + inv_2pi_dt / d_cutoff);
+    
+    float* val = value[axis];
+    float* dx = deriv[axis];
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+        float d = (v[i] - val[i]) / dt;
+        dx[i] += alpha_d * (d - dx[i]);
+        
+        float cutoff = min_cutoff + beta * fabsf(dx[i]);
+        float alpha = 1.0f / (1.0f + inv_2pi_dt / cutoff);
+        val[i] += alpha * (v[i] - val[i]);
+        v[i] = val[i];
+    }
+}
+
+//--------------------------------------------------------------
+void landmarkFilter::kalman(float* v, int axis, float dt){
+    
+    // discretized white-noise acceleration model
+    const float q00 = process_noise * dt * dt * dt / 3.0f;
+    const float q01 = process_noise * dt * dt / 2.0f;
+    const float q11 = process_noise * dt;
+    const float r = measurement_noise;
+    
+    float* x = pos[axis];
+    float* xv = vel[axis];
+    float* c00 = p00[axis];
+    float* c01 = p01[axis];
+    float* c11 = p11[axis];
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+        // predict
+        x[i] += xv[i] * dt;
+        float a00 = c00[i] + dt * (2.0f * c01[i] + dt * c11[i]) + q00;
+        float a01 = c01[i] + dt * c11[i] + q01;
+        float a11 = c11[i] + q11;
+        
+        // correct with the measured position
+        float s = 1.0f / (a00 + r);
+        float k0 = a00 * s;
+        float k1 = a01 * s;
+        float y = v[i] - x[i];
+        x[i] += k0 * y;
+        xv[i] += k1 * y;
+        c00[i] = (1.0f - k0) * a00;
+        c01[i] = (1.0f - k0) * a01;
+        c11[i] = a11 - k1 * a01;
+        
+        v[i] = x[i];
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "handFrame.h"
+
+/**
+ Smooths the landmarks of a HandFrame in place.
+ 
+ Every coordinate (21 landmarks x 3 axes) is filtered independently. State
+ is kept as flat float arrays in the same x/y/z layout as HandFrame, so each
+ step is a short branch-free loop the compiler can vectorize. Nothing is
+ allocated after construction.
+ 
+ - One Euro: adaptive low-pass, smooth when still, responsive when moving
+   (Casiez et al., "1 Euro Filter", CHI 2012)
+ - Kalman: constant-velocity model per coordinate
+ */
+
+enum landmarkFilterMode{
+    LANDMARK_FILTER_NONE = 0,
+    LANDMARK_FILTER_ONE_EURO,
+    LANDMARK_FILTER_KALMAN
+};
+
+class landmarkFilter{
+
+    public:
+        void setMode(landmarkFilterMode newMode);
+        landmarkFilterMode getMode() const { return mode; }
+    
+        // cutoffs in Hz, beta scales the cutoff with speed (normalized units/sec)
+        void setOneEuro(float min_cutoff, float beta, float d_cutoff);
+        // process noise (acceleration variance) and measurement noise (variance)
+        void setKalman(float process_noise, float measurement_noise);
+    
+        // forget the filter state; the next frame passes through unchanged
+        void reset();
+    
+        // filter frame.x/y/z in place, timed by frame.timestamp_usec. Returns
+        // false for a frame older than the last one (reordered in transit):
+        // it can't be smoothed without rewinding the state, and the filtered
+        // frames either side of it already cover that time, so drop it.
+        bool apply(HandFrame& frame);
+    
+    private:
+        void one_euro(float* v, int axis, float dt);
+        void kalman(float* v, int axis, float dt);
+    
+        landmarkFilterMode mode = LANDMARK_FILTER_ONE_EURO;
+    
+        float min_cutoff = 1.0;
+        float beta = 5.0;
+        float d_cutoff = 1.0;
+    
+        float process_noise = 0.5;
+        float measurement_noise = 0.00001;
+    
+        bool primed = false;
+        int num_landmarks = 0;
+        int64_t last_timestamp = 0;
+    
+        // one euro: filtered value and filtered derivative
+        float value[3][NUM_HAND_LANDMARKS];
+        float deriv[3][NUM_HAND_LANDMARKS];
+    
+        // kalman: position, velocity and the symmetric 2x2 covariance
+        float pos[3][NUM_HAND_LANDMARKS];
+        float vel[3][NUM_HAND_LANDMARKS];
+        float p00[3][NUM_HAND_LANDMARKS];
+        float p01[3][NUM_HAND_LANDMARKS];
+        float p11[3][NUM_HAND_LANDMARKS];
+};
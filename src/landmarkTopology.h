@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ Landmark counts and connections of the MediaPipe body models, as
+ compile-time tables.
+
+ Each model is written down as polylines (landmark indices, with
+ TOPOLOGY_BREAK between lines), the way the MediaPipe graphs describe them;
+ make_connections() turns that into the flat list of index pairs that
+ GL_LINES wants while compiling, so nothing is built at runtime.
+ skeletonRenderer takes a landmarkTopology, so drawing another model is
+ just adding a table here, and ofApp's fingertip emitters read
+ HAND_FINGERTIPS. HandFrame, landmarkFilter and the particle attractors
+ are still sized for the hand (NUM_HAND_LANDMARKS comes from its table)
+ and can't hold the body or face models yet.
+
+ No openFrameworks types, so the headless receiver can use it too.
+ */
+
+#define TOPOLOGY_BREAK 0xffffffffu
+
+struct landmarkTopology{
+    const char* name;
+    int num_landmarks;
+    const unsigned* connections;    // pairs of landmark indices
+    int num_connections;
+};
+
+// number of segments in a polyline list
+constexpr int count_connections(const unsigned* polylines, int n){
+    int count = 0;
+    for (int i=1; i<n; i++){
+        if (polylines[i] != TOPOLOGY_BREAK && polylines[i - 1] != TOPOLOGY_BREAK)
+            count++;
+    }
+    return count;
+}
+
+template <int N>
+struct connectionTable{
+    unsigned index[N * 2];
+};
+
+// polylines -> index pairs, one pair per segment
+template <int N>
+constexpr connectionTable<N> make_connections(const unsigned* polylines, int n){
+    connectionTable<N> table = {};
+    int k = 0;
+    for (int i=1; i<n; i++){
+        if (polylines[i] != TOPOLOGY_BREAK && polylines[i - 1] != TOPOLOGY_BREAK){
+            table.index[k++] = polylines[i - 1];
+            table.index[k++] = polylines[i];
+        }
+    }
+    return table;
+}
+
+// largest index used, to check the tables against their landmark count
+constexpr unsigned max_landmark(const unsigned* polylines, int n){
+    unsigned m = 0;
+    for (int i=0; i<n; i++){
+        if (polylines[i] != TOPOLOGY_BREAK && polylines[i] > m)
+            m = polylines[i];
+    }
+    return m;
+}
+
+#define TOPOLOGY_TABLE(prefix, landmarks, polylines)                                                        \
+    constexpr int prefix##_NUM_LANDMARKS = landmarks;                                                       \
+    constexpr int prefix##_NUM_CONNECTIONS = count_connections(polylines, sizeof(polylines) / sizeof(unsigned)); \
+    constexpr connectionTable<prefix##_NUM_CONNECTIONS> prefix##_CONNECTIONS =                              \
+        make_connections<prefix##_NUM_CONNECTIONS>(polylines, sizeof(polylines) / sizeof(unsigned));        \
+    static_assert(max_landmark(polylines, sizeof(polylines) / sizeof(unsigned)) < landmarks,                \
+                  #prefix " topology uses a landmark it doesn't have");                                     \
+    constexpr landmarkTopology prefix##_TOPOLOGY = {#prefix, landmarks, prefix##_CONNECTIONS.index, prefix##_NUM_CONNECTIONS}
+
+//--------------------------------------------------------------
+// Hand, from mediapipe/graphs/hand_tracking/sub_graphs/renderer_cpu.pbtxt
+// (LandmarksToRenderDataCalculator landmark_connections)
+constexpr unsigned HAND_POLYLINES[] = {
+    0, 1, 2, 3, 4, TOPOLOGY_BREAK,              // thumb
+    0, 5, 6, 7, 8, TOPOLOGY_BREAK,              // index
+    5, 9, 10, 11, 12, TOPOLOGY_BREAK,           // middle
+    9, 13, 14, 15, 16, TOPOLOGY_BREAK,          // ring
+    13, 17, TOPOLOGY_BREAK,
+    0, 17, 18, 19, 20                           // pinky
+};
+TOPOLOGY_TABLE(HAND, 21, HAND_POLYLINES);
+
+// fingertips, thumb to pinky: the last landmark of each finger above
+constexpr unsigned HAND_FINGERTIPS[] = {4, 8, 12, 16, 20};
+constexpr int HAND_NUM_FINGERTIPS = sizeof(HAND_FINGERTIPS) / sizeof(unsigned);
+static_assert(max_landmark(HAND_FINGERTIPS, HAND_NUM_FINGERTIPS) < HAND_NUM_LANDMARKS,
+              "HAND fingertips use a landmark it doesn't have");
+
+//--------------------------------------------------------------
+// Pose (BlazePose, 33 landmarks), mediapipe/python/solutions/pose_connections.py
+constexpr unsigned POSE_POLYLINES[] = {
+    3, 2, 1, 0, 4, 5, 6, 8, TOPOLOGY_BREAK,     // eyes and nose
+    7, 3, TOPOLOGY_BREAK,
+    9, 10, TOPOLOGY_BREAK,                      // mouth
+    11, 12, 24, 23, 11, TOPOLOGY_BREAK,         // torso
+    11, 13, 15, 17, 19, 15, 21, TOPOLOGY_BREAK, // left arm and hand
+    12, 14, 16, 18, 20, 16, 22, TOPOLOGY_BREAK, // right arm and hand
+    23, 25, 27, 29, 31, 27, TOPOLOGY_BREAK,     // left leg and foot
+    24, 26, 28, 30, 32, 28                      // right leg and foot
+};
+TOPOLOGY_TABLE(POSE, 33, POSE_POLYLINES);
+
+//--------------------------------------------------------------
+// Face mesh (468 landmarks): the contours from
+// mediapipe/python/solutions/face_mesh_connections.py (FACEMESH_CONTOURS),
+// not the full tesselation
+constexpr unsigned FACE_POLYLINES[] = {
+    // lips, outer then inner
+    61, 146, 91, 181, 84, 17, 314, 405, 321, 375, 291, TOPOLOGY_BREAK,
+    61, 185, 40, 39, 37, 0, 267, 269, 270, 409, 291, TOPOLOGY_BREAK,
+    78, 95, 88, 178, 87, 14, 317, 402, 318, 324, 308, TOPOLOGY_BREAK,
+    78, 191, 80, 81, 82, 13, 312, 311, 310, 415, 308, TOPOLOGY_BREAK,
+    // left eye and eyebrow
+    263, 249, 390, 373, 374, 380, 381, 382, 362, TOPOLOGY_BREAK,
+    263, 466, 388, 387, 386, 385, 384, 398, 362, TOPOLOGY_BREAK,
+    276, 283, 282, 295, 285, TOPOLOGY_BREAK,
+    300, 293, 334, 296, 336, TOPOLOGY_BREAK,
+    // right eye and eyebrow
+    33, 7, 163, 144, 145, 153, 154, 155, 133, TOPOLOGY_BREAK,
+    33, 246, 161, 160, 159, 158, 157, 173, 133, TOPOLOGY_BREAK,
+    46, 53, 52, 65, 55, TOPOLOGY_BREAK,
+    70, 63, 105, 66, 107, TOPOLOGY_BREAK,
+    // face oval
+    10, 338, 297, 332, 284, 251, 389, 356, 454, 323, 361, 288, 397, 365, 379, 378, 400, 377,
+    152, 148, 176, 149, 150, 136, 172, 58, 132, 93, 234, 127, 162, 21, 54, 103, 67, 109, 10
+};
+TOPOLOGY_TABLE(FACE, 468, FACE_POLYLINES);
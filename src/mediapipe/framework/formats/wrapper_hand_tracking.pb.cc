@@ -33,6 +33,7 @@ extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapp
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto ::google::protobuf::internal::SCCInfo<1> scc_info_NormalizedLandmarkList;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto ::google::protobuf::internal::SCCInfo<1> scc_info_Rasterization;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto ::google::protobuf::internal::SCCInfo<2> scc_info_Detection;
+extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto ::google::protobuf::internal::SCCInfo<3> scc_info_WrapperHandTracking;
 extern PROTOBUF_INTERNAL_EXPORT_protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto ::google::protobuf::internal::SCCInfo<4> scc_info_LocationData;
 }  // namespace protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto
 namespace mediapipe {
@@ -121,6 +122,16 @@ class WrapperHandTrackingDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<WrapperHandTracking>
       _instance;
 } _WrapperHandTracking_default_instance_;
+class HandTrackingCaptureRecordDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<HandTrackingCaptureRecord>
+      _instance;
+} _HandTrackingCaptureRecord_default_instance_;
+class HandTrackingFeedbackDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<HandTrackingFeedback>
+      _instance;
+} _HandTrackingFeedback_default_instance_;
 }  // namespace mediapipe
 namespace protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto {
 static void InitDefaultsLandmark() {
@@ -375,6 +386,35 @@ static void InitDefaultsWrapperHandTracking() {
       &protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_NormalizedRect.base,
       &protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_DetectionList.base,}};
 
+static void InitDefaultsHandTrackingCaptureRecord() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::mediapipe::_HandTrackingCaptureRecord_default_instance_;
+    new (ptr) ::mediapipe::HandTrackingCaptureRecord();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::mediapipe::HandTrackingCaptureRecord::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<1> scc_info_HandTrackingCaptureRecord =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 1, InitDefaultsHandTrackingCaptureRecord}, {
+      &protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_WrapperHandTracking.base,}};
+
+static void InitDefaultsHandTrackingFeedback() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::mediapipe::_HandTrackingFeedback_default_instance_;
+    new (ptr) ::mediapipe::HandTrackingFeedback();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::mediapipe::HandTrackingFeedback::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<0> scc_info_HandTrackingFeedback =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsHandTrackingFeedback}, {}};
+
 void InitDefaults() {
   ::google::protobuf::internal::InitSCC(&scc_info_Landmark.base);
   ::google::protobuf::internal::InitSCC(&scc_info_LandmarkList.base);
@@ -393,9 +433,11 @@ void InitDefaults() {
   ::google::protobuf::internal::InitSCC(&scc_info_Detection.base);
   ::google::protobuf::internal::InitSCC(&scc_info_DetectionList.base);
   ::google::protobuf::internal::InitSCC(&scc_info_WrapperHandTracking.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_HandTrackingCaptureRecord.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_HandTrackingFeedback.base);
 }
 
-::google::protobuf::Metadata file_level_metadata[17];
+::google::protobuf::Metadata file_level_metadata[19];
 const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[1];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
@@ -601,9 +643,43 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, landmarks_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, rect_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, detection_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, timestamp_usec_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, sequence_id_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::WrapperHandTracking, send_time_usec_),
+  0,
+  1,
+  2,
+  3,
+  4,
+  5,
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, _has_bits_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, receive_usec_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, source_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, frame_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingCaptureRecord, receive_wall_usec_),
+  1,
+  3,
+  0,
+  2,
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, _has_bits_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, received_per_sec_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, consumed_per_sec_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, queue_depth_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, loss_percent_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::mediapipe::HandTrackingFeedback, datagrams_per_sec_),
   0,
   1,
   2,
+  3,
+  4,
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, 8, sizeof(::mediapipe::Landmark)},
@@ -622,7 +698,9 @@ static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROT
   { 153, 160, sizeof(::mediapipe::Detection_AssociatedDetection)},
   { 162, 177, sizeof(::mediapipe::Detection)},
   { 187, 193, sizeof(::mediapipe::DetectionList)},
-  { 194, 202, sizeof(::mediapipe::WrapperHandTracking)},
+  { 194, 205, sizeof(::mediapipe::WrapperHandTracking)},
+  { 211, 220, sizeof(::mediapipe::HandTrackingCaptureRecord)},
+  { 224, 234, sizeof(::mediapipe::HandTrackingFeedback)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
@@ -643,6 +721,8 @@ static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::mediapipe::_Detection_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::mediapipe::_DetectionList_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::mediapipe::_WrapperHandTracking_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::mediapipe::_HandTrackingCaptureRecord_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::mediapipe::_HandTrackingFeedback_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -660,7 +740,7 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 17);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 19);
 }
 
 void AddDescriptorsImpl() {
@@ -711,14 +791,23 @@ void AddDescriptorsImpl() {
       "\030\n \001(\003\0325\n\023AssociatedDetection\022\n\n\002id\030\001 \001("
       "\005\022\022\n\nconfidence\030\002 \001(\002\"8\n\rDetectionList\022\'"
       "\n\tdetection\030\001 \003(\0132\024.mediapipe.Detection\""
-      "\241\001\n\023WrapperHandTracking\0224\n\tlandmarks\030\001 \001"
+      "\346\001\n\023WrapperHandTracking\0224\n\tlandmarks\030\001 \001"
       "(\0132!.mediapipe.NormalizedLandmarkList\022\'\n"
       "\004rect\030\002 \001(\0132\031.mediapipe.NormalizedRect\022+"
       "\n\tdetection\030\003 \001(\0132\030.mediapipe.DetectionL"
-      "ist"
+      "ist\022\026\n\016timestamp_usec\030\004 \001(\003\022\023\n\013sequence_"
+      "id\030\005 \001(\004\022\026\n\016send_time_usec\030\006 \001(\003\"\213\001\n\031Han"
+      "dTrackingCaptureRecord\022\024\n\014receive_usec\030\001"
+      " \001(\003\022\016\n\006source\030\002 \001(\005\022-\n\005frame\030\003 \001(\0132\036.me"
+      "diapipe.WrapperHandTracking\022\031\n\021receive_w"
+      "all_usec\030\004 \001(\003\"\220\001\n\024HandTrackingFeedback\022"
+      "\030\n\020received_per_sec\030\001 \001(\002\022\030\n\020consumed_pe"
+      "r_sec\030\002 \001(\002\022\023\n\013queue_depth\030\003 \001(\r\022\024\n\014loss"
+      "_percent\030\004 \001(\002\022\031\n\021datagrams_per_sec\030\005 \001("
+      "\002"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 1963);
+      descriptor, 2321);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "mediapipe/framework/formats/wrapper_hand_tracking.proto", &protobuf_RegisterTypes);
 }
@@ -6386,6 +6475,9 @@ void WrapperHandTracking::InitAsDefaultInstance() {
 const int WrapperHandTracking::kLandmarksFieldNumber;
 const int WrapperHandTracking::kRectFieldNumber;
 const int WrapperHandTracking::kDetectionFieldNumber;
+const int WrapperHandTracking::kTimestampUsecFieldNumber;
+const int WrapperHandTracking::kSequenceIdFieldNumber;
+const int WrapperHandTracking::kSendTimeUsecFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 WrapperHandTracking::WrapperHandTracking()
@@ -6415,13 +6507,16 @@ WrapperHandTracking::WrapperHandTracking(const WrapperHandTracking& from)
   } else {
     detection_ = NULL;
   }
+  ::memcpy(&timestamp_usec_, &from.timestamp_usec_,
+    static_cast<size_t>(reinterpret_cast<char*>(&send_time_usec_) -
+    reinterpret_cast<char*>(&timestamp_usec_)) + sizeof(send_time_usec_));
   // @@protoc_insertion_point(copy_constructor:mediapipe.WrapperHandTracking)
 }
 
 void WrapperHandTracking::SharedCtor() {
   ::memset(&landmarks_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&detection_) -
-      reinterpret_cast<char*>(&landmarks_)) + sizeof(detection_));
+      reinterpret_cast<char*>(&send_time_usec_) -
+      reinterpret_cast<char*>(&landmarks_)) + sizeof(send_time_usec_));
 }
 
 WrapperHandTracking::~WrapperHandTracking() {
@@ -6470,6 +6565,11 @@ void WrapperHandTracking::Clear() {
       detection_->Clear();
     }
   }
+  if (cached_has_bits & 56u) {
+    ::memset(&timestamp_usec_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&send_time_usec_) -
+        reinterpret_cast<char*>(&timestamp_usec_)) + sizeof(send_time_usec_));
+  }
   _has_bits_.Clear();
   _internal_metadata_.Clear();
 }
@@ -6520,6 +6620,48 @@ bool WrapperHandTracking::MergePartialFromCodedStream(
         break;
       }
 
+      // optional int64 timestamp_usec = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+          set_has_timestamp_usec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &timestamp_usec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional uint64 sequence_id = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(40u /* 40 & 0xFF */)) {
+          set_has_sequence_id();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &sequence_id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional int64 send_time_usec = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(48u /* 48 & 0xFF */)) {
+          set_has_send_time_usec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &send_time_usec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -6565,6 +6707,21 @@ void WrapperHandTracking::SerializeWithCachedSizes(
       3, this->_internal_detection(), output);
   }
 
+  // optional int64 timestamp_usec = 4;
+  if (cached_has_bits & 0x00000008u) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(4, this->timestamp_usec(), output);
+  }
+
+  // optional uint64 sequence_id = 5;
+  if (cached_has_bits & 0x00000010u) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(5, this->sequence_id(), output);
+  }
+
+  // optional int64 send_time_usec = 6;
+  if (cached_has_bits & 0x00000020u) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(6, this->send_time_usec(), output);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         _internal_metadata_.unknown_fields(), output);
@@ -6601,6 +6758,21 @@ void WrapperHandTracking::SerializeWithCachedSizes(
         3, this->_internal_detection(), deterministic, target);
   }
 
+  // optional int64 timestamp_usec = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(4, this->timestamp_usec(), target);
+  }
+
+  // optional uint64 sequence_id = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(5, this->sequence_id(), target);
+  }
+
+  // optional int64 send_time_usec = 6;
+  if (cached_has_bits & 0x00000020u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(6, this->send_time_usec(), target);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target);
@@ -6618,7 +6790,7 @@ size_t WrapperHandTracking::ByteSizeLong() const {
       ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
         _internal_metadata_.unknown_fields());
   }
-  if (_has_bits_[0 / 32] & 7u) {
+  if (_has_bits_[0 / 32] & 63u) {
     // optional .mediapipe.NormalizedLandmarkList landmarks = 1;
     if (has_landmarks()) {
       total_size += 1 +
@@ -6640,6 +6812,27 @@ size_t WrapperHandTracking::ByteSizeLong() const {
           *detection_);
     }
 
+    // optional int64 timestamp_usec = 4;
+    if (has_timestamp_usec()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int64Size(
+          this->timestamp_usec());
+    }
+
+    // optional uint64 sequence_id = 5;
+    if (has_sequence_id()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt64Size(
+          this->sequence_id());
+    }
+
+    // optional int64 send_time_usec = 6;
+    if (has_send_time_usec()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int64Size(
+          this->send_time_usec());
+    }
+
   }
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   SetCachedSize(cached_size);
@@ -6669,7 +6862,7 @@ void WrapperHandTracking::MergeFrom(const WrapperHandTracking& from) {
   (void) cached_has_bits;
 
   cached_has_bits = from._has_bits_[0];
-  if (cached_has_bits & 7u) {
+  if (cached_has_bits & 63u) {
     if (cached_has_bits & 0x00000001u) {
       mutable_landmarks()->::mediapipe::NormalizedLandmarkList::MergeFrom(from.landmarks());
     }
@@ -6679,6 +6872,16 @@ void WrapperHandTracking::MergeFrom(const WrapperHandTracking& from) {
     if (cached_has_bits & 0x00000004u) {
       mutable_detection()->::mediapipe::DetectionList::MergeFrom(from.detection());
     }
+    if (cached_has_bits & 0x00000008u) {
+      timestamp_usec_ = from.timestamp_usec_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      sequence_id_ = from.sequence_id_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      send_time_usec_ = from.send_time_usec_;
+    }
+    _has_bits_[0] |= cached_has_bits;
   }
 }
 
@@ -6715,6 +6918,9 @@ void WrapperHandTracking::InternalSwap(WrapperHandTracking* other) {
   swap(landmarks_, other->landmarks_);
   swap(rect_, other->rect_);
   swap(detection_, other->detection_);
+  swap(timestamp_usec_, other->timestamp_usec_);
+  swap(sequence_id_, other->sequence_id_);
+  swap(send_time_usec_, other->send_time_usec_);
   swap(_has_bits_[0], other->_has_bits_[0]);
   _internal_metadata_.Swap(&other->_internal_metadata_);
 }
@@ -6725,53 +6931,799 @@ void WrapperHandTracking::InternalSwap(WrapperHandTracking* other) {
 }
 
 
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace mediapipe
-namespace google {
-namespace protobuf {
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Landmark* Arena::CreateMaybeMessage< ::mediapipe::Landmark >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::Landmark >(arena);
-}
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LandmarkList* Arena::CreateMaybeMessage< ::mediapipe::LandmarkList >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LandmarkList >(arena);
-}
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedLandmark* Arena::CreateMaybeMessage< ::mediapipe::NormalizedLandmark >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::NormalizedLandmark >(arena);
-}
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedLandmarkList* Arena::CreateMaybeMessage< ::mediapipe::NormalizedLandmarkList >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::NormalizedLandmarkList >(arena);
+// ===================================================================
+
+void HandTrackingCaptureRecord::InitAsDefaultInstance() {
+  ::mediapipe::_HandTrackingCaptureRecord_default_instance_._instance.get_mutable()->frame_ = const_cast< ::mediapipe::WrapperHandTracking*>(
+      ::mediapipe::WrapperHandTracking::internal_default_instance());
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rect* Arena::CreateMaybeMessage< ::mediapipe::Rect >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::Rect >(arena);
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int HandTrackingCaptureRecord::kReceiveUsecFieldNumber;
+const int HandTrackingCaptureRecord::kSourceFieldNumber;
+const int HandTrackingCaptureRecord::kFrameFieldNumber;
+const int HandTrackingCaptureRecord::kReceiveWallUsecFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+HandTrackingCaptureRecord::HandTrackingCaptureRecord()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_HandTrackingCaptureRecord.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:mediapipe.HandTrackingCaptureRecord)
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedRect* Arena::CreateMaybeMessage< ::mediapipe::NormalizedRect >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::NormalizedRect >(arena);
+HandTrackingCaptureRecord::HandTrackingCaptureRecord(const HandTrackingCaptureRecord& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      _has_bits_(from._has_bits_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  if (from.has_frame()) {
+    frame_ = new ::mediapipe::WrapperHandTracking(*from.frame_);
+  } else {
+    frame_ = NULL;
+  }
+  ::memcpy(&receive_usec_, &from.receive_usec_,
+    static_cast<size_t>(reinterpret_cast<char*>(&source_) -
+    reinterpret_cast<char*>(&receive_usec_)) + sizeof(source_));
+  // @@protoc_insertion_point(copy_constructor:mediapipe.HandTrackingCaptureRecord)
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rasterization_Interval* Arena::CreateMaybeMessage< ::mediapipe::Rasterization_Interval >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::Rasterization_Interval >(arena);
+
+void HandTrackingCaptureRecord::SharedCtor() {
+  ::memset(&frame_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&source_) -
+      reinterpret_cast<char*>(&frame_)) + sizeof(source_));
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rasterization* Arena::CreateMaybeMessage< ::mediapipe::Rasterization >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::Rasterization >(arena);
+
+HandTrackingCaptureRecord::~HandTrackingCaptureRecord() {
+  // @@protoc_insertion_point(destructor:mediapipe.HandTrackingCaptureRecord)
+  SharedDtor();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_BoundingBox* Arena::CreateMaybeMessage< ::mediapipe::LocationData_BoundingBox >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LocationData_BoundingBox >(arena);
+
+void HandTrackingCaptureRecord::SharedDtor() {
+  if (this != internal_default_instance()) delete frame_;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_RelativeBoundingBox* Arena::CreateMaybeMessage< ::mediapipe::LocationData_RelativeBoundingBox >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LocationData_RelativeBoundingBox >(arena);
+
+void HandTrackingCaptureRecord::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_BinaryMask* Arena::CreateMaybeMessage< ::mediapipe::LocationData_BinaryMask >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LocationData_BinaryMask >(arena);
+const ::google::protobuf::Descriptor* HandTrackingCaptureRecord::descriptor() {
+  ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_RelativeKeypoint* Arena::CreateMaybeMessage< ::mediapipe::LocationData_RelativeKeypoint >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LocationData_RelativeKeypoint >(arena);
+
+const HandTrackingCaptureRecord& HandTrackingCaptureRecord::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_HandTrackingCaptureRecord.base);
+  return *internal_default_instance();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData* Arena::CreateMaybeMessage< ::mediapipe::LocationData >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::LocationData >(arena);
+
+
+void HandTrackingCaptureRecord::Clear() {
+// @@protoc_insertion_point(message_clear_start:mediapipe.HandTrackingCaptureRecord)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    GOOGLE_DCHECK(frame_ != NULL);
+    frame_->Clear();
+  }
+  if (cached_has_bits & 14u) {
+    ::memset(&receive_usec_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&source_) -
+        reinterpret_cast<char*>(&receive_usec_)) + sizeof(source_));
+  }
+  _has_bits_.Clear();
+  _internal_metadata_.Clear();
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Detection_AssociatedDetection* Arena::CreateMaybeMessage< ::mediapipe::Detection_AssociatedDetection >(Arena* arena) {
-  return Arena::CreateInternal< ::mediapipe::Detection_AssociatedDetection >(arena);
+
+bool HandTrackingCaptureRecord::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:mediapipe.HandTrackingCaptureRecord)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional int64 receive_usec = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(8u /* 8 & 0xFF */)) {
+          set_has_receive_usec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &receive_usec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional int32 source = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(16u /* 16 & 0xFF */)) {
+          set_has_source();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
+                 input, &source_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional .mediapipe.WrapperHandTracking frame = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(26u /* 26 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+               input, mutable_frame()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional int64 receive_wall_usec = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+          set_has_receive_wall_usec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &receive_wall_usec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:mediapipe.HandTrackingCaptureRecord)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:mediapipe.HandTrackingCaptureRecord)
+  return false;
+#undef DO_
 }
-template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Detection* Arena::CreateMaybeMessage< ::mediapipe::Detection >(Arena* arena) {
+
+void HandTrackingCaptureRecord::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:mediapipe.HandTrackingCaptureRecord)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  // optional int64 receive_usec = 1;
+  if (cached_has_bits & 0x00000002u) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->receive_usec(), output);
+  }
+
+  // optional int32 source = 2;
+  if (cached_has_bits & 0x00000008u) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt32(2, this->source(), output);
+  }
+
+  // optional .mediapipe.WrapperHandTracking frame = 3;
+  if (cached_has_bits & 0x00000001u) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      3, this->_internal_frame(), output);
+  }
+
+  // optional int64 receive_wall_usec = 4;
+  if (cached_has_bits & 0x00000004u) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(4, this->receive_wall_usec(), output);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        _internal_metadata_.unknown_fields(), output);
+  }
+  // @@protoc_insertion_point(serialize_end:mediapipe.HandTrackingCaptureRecord)
+}
+
+::google::protobuf::uint8* HandTrackingCaptureRecord::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:mediapipe.HandTrackingCaptureRecord)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  // optional int64 receive_usec = 1;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->receive_usec(), target);
+  }
+
+  // optional int32 source = 2;
+  if (cached_has_bits & 0x00000008u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(2, this->source(), target);
+  }
+
+  // optional .mediapipe.WrapperHandTracking frame = 3;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        3, this->_internal_frame(), deterministic, target);
+  }
+
+  // optional int64 receive_wall_usec = 4;
+  if (cached_has_bits & 0x00000004u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(4, this->receive_wall_usec(), target);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:mediapipe.HandTrackingCaptureRecord)
+  return target;
+}
+
+size_t HandTrackingCaptureRecord::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mediapipe.HandTrackingCaptureRecord)
+  size_t total_size = 0;
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields());
+  }
+  if (_has_bits_[0 / 32] & 15u) {
+    // optional .mediapipe.WrapperHandTracking frame = 3;
+    if (has_frame()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          *frame_);
+    }
+
+    // optional int64 receive_usec = 1;
+    if (has_receive_usec()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int64Size(
+          this->receive_usec());
+    }
+
+    // optional int64 receive_wall_usec = 4;
+    if (has_receive_wall_usec()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int64Size(
+          this->receive_wall_usec());
+    }
+
+    // optional int32 source = 2;
+    if (has_source()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::Int32Size(
+          this->source());
+    }
+
+  }
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void HandTrackingCaptureRecord::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:mediapipe.HandTrackingCaptureRecord)
+  GOOGLE_DCHECK_NE(&from, this);
+  const HandTrackingCaptureRecord* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const HandTrackingCaptureRecord>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:mediapipe.HandTrackingCaptureRecord)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:mediapipe.HandTrackingCaptureRecord)
+    MergeFrom(*source);
+  }
+}
+
+void HandTrackingCaptureRecord::MergeFrom(const HandTrackingCaptureRecord& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:mediapipe.HandTrackingCaptureRecord)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._has_bits_[0];
+  if (cached_has_bits & 15u) {
+    if (cached_has_bits & 0x00000001u) {
+      mutable_frame()->::mediapipe::WrapperHandTracking::MergeFrom(from.frame());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      receive_usec_ = from.receive_usec_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      receive_wall_usec_ = from.receive_wall_usec_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      source_ = from.source_;
+    }
+    _has_bits_[0] |= cached_has_bits;
+  }
+}
+
+void HandTrackingCaptureRecord::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:mediapipe.HandTrackingCaptureRecord)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void HandTrackingCaptureRecord::CopyFrom(const HandTrackingCaptureRecord& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mediapipe.HandTrackingCaptureRecord)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool HandTrackingCaptureRecord::IsInitialized() const {
+  if (has_frame()) {
+    if (!this->frame_->IsInitialized()) return false;
+  }
+  return true;
+}
+
+void HandTrackingCaptureRecord::Swap(HandTrackingCaptureRecord* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void HandTrackingCaptureRecord::InternalSwap(HandTrackingCaptureRecord* other) {
+  using std::swap;
+  swap(frame_, other->frame_);
+  swap(receive_usec_, other->receive_usec_);
+  swap(receive_wall_usec_, other->receive_wall_usec_);
+  swap(source_, other->source_);
+  swap(_has_bits_[0], other->_has_bits_[0]);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata HandTrackingCaptureRecord::GetMetadata() const {
+  protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// ===================================================================
+
+void HandTrackingFeedback::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int HandTrackingFeedback::kReceivedPerSecFieldNumber;
+const int HandTrackingFeedback::kConsumedPerSecFieldNumber;
+const int HandTrackingFeedback::kQueueDepthFieldNumber;
+const int HandTrackingFeedback::kLossPercentFieldNumber;
+const int HandTrackingFeedback::kDatagramsPerSecFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+HandTrackingFeedback::HandTrackingFeedback()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_HandTrackingFeedback.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:mediapipe.HandTrackingFeedback)
+}
+HandTrackingFeedback::HandTrackingFeedback(const HandTrackingFeedback& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      _has_bits_(from._has_bits_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::memcpy(&received_per_sec_, &from.received_per_sec_,
+    static_cast<size_t>(reinterpret_cast<char*>(&datagrams_per_sec_) -
+    reinterpret_cast<char*>(&received_per_sec_)) + sizeof(datagrams_per_sec_));
+  // @@protoc_insertion_point(copy_constructor:mediapipe.HandTrackingFeedback)
+}
+
+void HandTrackingFeedback::SharedCtor() {
+  ::memset(&received_per_sec_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&datagrams_per_sec_) -
+      reinterpret_cast<char*>(&received_per_sec_)) + sizeof(datagrams_per_sec_));
+}
+
+HandTrackingFeedback::~HandTrackingFeedback() {
+  // @@protoc_insertion_point(destructor:mediapipe.HandTrackingFeedback)
+  SharedDtor();
+}
+
+void HandTrackingFeedback::SharedDtor() {
+}
+
+void HandTrackingFeedback::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ::google::protobuf::Descriptor* HandTrackingFeedback::descriptor() {
+  ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const HandTrackingFeedback& HandTrackingFeedback::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::scc_info_HandTrackingFeedback.base);
+  return *internal_default_instance();
+}
+
+
+void HandTrackingFeedback::Clear() {
+// @@protoc_insertion_point(message_clear_start:mediapipe.HandTrackingFeedback)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  if (cached_has_bits & 31u) {
+    ::memset(&received_per_sec_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&datagrams_per_sec_) -
+        reinterpret_cast<char*>(&received_per_sec_)) + sizeof(datagrams_per_sec_));
+  }
+  _has_bits_.Clear();
+  _internal_metadata_.Clear();
+}
+
+bool HandTrackingFeedback::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:mediapipe.HandTrackingFeedback)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional float received_per_sec = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(13u /* 13 & 0xFF */)) {
+          set_has_received_per_sec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &received_per_sec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional float consumed_per_sec = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(21u /* 21 & 0xFF */)) {
+          set_has_consumed_per_sec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &consumed_per_sec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional uint32 queue_depth = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+          set_has_queue_depth();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &queue_depth_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional float loss_percent = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(37u /* 37 & 0xFF */)) {
+          set_has_loss_percent();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &loss_percent_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // optional float datagrams_per_sec = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(45u /* 45 & 0xFF */)) {
+          set_has_datagrams_per_sec();
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &datagrams_per_sec_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:mediapipe.HandTrackingFeedback)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:mediapipe.HandTrackingFeedback)
+  return false;
+#undef DO_
+}
+
+void HandTrackingFeedback::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:mediapipe.HandTrackingFeedback)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  // optional float received_per_sec = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(1, this->received_per_sec(), output);
+  }
+
+  // optional float consumed_per_sec = 2;
+  if (cached_has_bits & 0x00000002u) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(2, this->consumed_per_sec(), output);
+  }
+
+  // optional uint32 queue_depth = 3;
+  if (cached_has_bits & 0x00000004u) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(3, this->queue_depth(), output);
+  }
+
+  // optional float loss_percent = 4;
+  if (cached_has_bits & 0x00000008u) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(4, this->loss_percent(), output);
+  }
+
+  // optional float datagrams_per_sec = 5;
+  if (cached_has_bits & 0x00000010u) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(5, this->datagrams_per_sec(), output);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        _internal_metadata_.unknown_fields(), output);
+  }
+  // @@protoc_insertion_point(serialize_end:mediapipe.HandTrackingFeedback)
+}
+
+::google::protobuf::uint8* HandTrackingFeedback::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:mediapipe.HandTrackingFeedback)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _has_bits_[0];
+  // optional float received_per_sec = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(1, this->received_per_sec(), target);
+  }
+
+  // optional float consumed_per_sec = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(2, this->consumed_per_sec(), target);
+  }
+
+  // optional uint32 queue_depth = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(3, this->queue_depth(), target);
+  }
+
+  // optional float loss_percent = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(4, this->loss_percent(), target);
+  }
+
+  // optional float datagrams_per_sec = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(5, this->datagrams_per_sec(), target);
+  }
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:mediapipe.HandTrackingFeedback)
+  return target;
+}
+
+size_t HandTrackingFeedback::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:mediapipe.HandTrackingFeedback)
+  size_t total_size = 0;
+
+  if (_internal_metadata_.have_unknown_fields()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        _internal_metadata_.unknown_fields());
+  }
+  if (_has_bits_[0 / 32] & 31u) {
+    // optional float received_per_sec = 1;
+    if (has_received_per_sec()) {
+      total_size += 1 + 4;
+    }
+
+    // optional float consumed_per_sec = 2;
+    if (has_consumed_per_sec()) {
+      total_size += 1 + 4;
+    }
+
+    // optional uint32 queue_depth = 3;
+    if (has_queue_depth()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->queue_depth());
+    }
+
+    // optional float loss_percent = 4;
+    if (has_loss_percent()) {
+      total_size += 1 + 4;
+    }
+
+    // optional float datagrams_per_sec = 5;
+    if (has_datagrams_per_sec()) {
+      total_size += 1 + 4;
+    }
+
+  }
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void HandTrackingFeedback::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:mediapipe.HandTrackingFeedback)
+  GOOGLE_DCHECK_NE(&from, this);
+  const HandTrackingFeedback* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const HandTrackingFeedback>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:mediapipe.HandTrackingFeedback)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:mediapipe.HandTrackingFeedback)
+    MergeFrom(*source);
+  }
+}
+
+void HandTrackingFeedback::MergeFrom(const HandTrackingFeedback& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:mediapipe.HandTrackingFeedback)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._has_bits_[0];
+  if (cached_has_bits & 31u) {
+    if (cached_has_bits & 0x00000001u) {
+      received_per_sec_ = from.received_per_sec_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      consumed_per_sec_ = from.consumed_per_sec_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      queue_depth_ = from.queue_depth_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      loss_percent_ = from.loss_percent_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      datagrams_per_sec_ = from.datagrams_per_sec_;
+    }
+    _has_bits_[0] |= cached_has_bits;
+  }
+}
+
+void HandTrackingFeedback::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:mediapipe.HandTrackingFeedback)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void HandTrackingFeedback::CopyFrom(const HandTrackingFeedback& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:mediapipe.HandTrackingFeedback)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool HandTrackingFeedback::IsInitialized() const {
+  return true;
+}
+
+void HandTrackingFeedback::Swap(HandTrackingFeedback* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void HandTrackingFeedback::InternalSwap(HandTrackingFeedback* other) {
+  using std::swap;
+  swap(received_per_sec_, other->received_per_sec_);
+  swap(consumed_per_sec_, other->consumed_per_sec_);
+  swap(queue_depth_, other->queue_depth_);
+  swap(loss_percent_, other->loss_percent_);
+  swap(datagrams_per_sec_, other->datagrams_per_sec_);
+  swap(_has_bits_[0], other->_has_bits_[0]);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata HandTrackingFeedback::GetMetadata() const {
+  protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace mediapipe
+namespace google {
+namespace protobuf {
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Landmark* Arena::CreateMaybeMessage< ::mediapipe::Landmark >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::Landmark >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LandmarkList* Arena::CreateMaybeMessage< ::mediapipe::LandmarkList >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LandmarkList >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedLandmark* Arena::CreateMaybeMessage< ::mediapipe::NormalizedLandmark >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::NormalizedLandmark >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedLandmarkList* Arena::CreateMaybeMessage< ::mediapipe::NormalizedLandmarkList >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::NormalizedLandmarkList >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rect* Arena::CreateMaybeMessage< ::mediapipe::Rect >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::Rect >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::NormalizedRect* Arena::CreateMaybeMessage< ::mediapipe::NormalizedRect >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::NormalizedRect >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rasterization_Interval* Arena::CreateMaybeMessage< ::mediapipe::Rasterization_Interval >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::Rasterization_Interval >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Rasterization* Arena::CreateMaybeMessage< ::mediapipe::Rasterization >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::Rasterization >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_BoundingBox* Arena::CreateMaybeMessage< ::mediapipe::LocationData_BoundingBox >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LocationData_BoundingBox >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_RelativeBoundingBox* Arena::CreateMaybeMessage< ::mediapipe::LocationData_RelativeBoundingBox >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LocationData_RelativeBoundingBox >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_BinaryMask* Arena::CreateMaybeMessage< ::mediapipe::LocationData_BinaryMask >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LocationData_BinaryMask >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData_RelativeKeypoint* Arena::CreateMaybeMessage< ::mediapipe::LocationData_RelativeKeypoint >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LocationData_RelativeKeypoint >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::LocationData* Arena::CreateMaybeMessage< ::mediapipe::LocationData >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::LocationData >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Detection_AssociatedDetection* Arena::CreateMaybeMessage< ::mediapipe::Detection_AssociatedDetection >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::Detection_AssociatedDetection >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::Detection* Arena::CreateMaybeMessage< ::mediapipe::Detection >(Arena* arena) {
   return Arena::CreateInternal< ::mediapipe::Detection >(arena);
 }
 template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::DetectionList* Arena::CreateMaybeMessage< ::mediapipe::DetectionList >(Arena* arena) {
@@ -6780,6 +7732,12 @@ template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::DetectionList* Arena:
 template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::WrapperHandTracking* Arena::CreateMaybeMessage< ::mediapipe::WrapperHandTracking >(Arena* arena) {
   return Arena::CreateInternal< ::mediapipe::WrapperHandTracking >(arena);
 }
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::HandTrackingCaptureRecord* Arena::CreateMaybeMessage< ::mediapipe::HandTrackingCaptureRecord >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::HandTrackingCaptureRecord >(arena);
+}
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::mediapipe::HandTrackingFeedback* Arena::CreateMaybeMessage< ::mediapipe::HandTrackingFeedback >(Arena* arena) {
+  return Arena::CreateInternal< ::mediapipe::HandTrackingFeedback >(arena);
+}
 }  // namespace protobuf
 }  // namespace google
 
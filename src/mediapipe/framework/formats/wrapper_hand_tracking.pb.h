@@ -39,7 +39,7 @@ namespace protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[17];
+  static const ::google::protobuf::internal::ParseTable schema[19];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -56,6 +56,12 @@ extern DetectionListDefaultTypeInternal _DetectionList_default_instance_;
 class Detection_AssociatedDetection;
 class Detection_AssociatedDetectionDefaultTypeInternal;
 extern Detection_AssociatedDetectionDefaultTypeInternal _Detection_AssociatedDetection_default_instance_;
+class HandTrackingCaptureRecord;
+class HandTrackingCaptureRecordDefaultTypeInternal;
+extern HandTrackingCaptureRecordDefaultTypeInternal _HandTrackingCaptureRecord_default_instance_;
+class HandTrackingFeedback;
+class HandTrackingFeedbackDefaultTypeInternal;
+extern HandTrackingFeedbackDefaultTypeInternal _HandTrackingFeedback_default_instance_;
 class Landmark;
 class LandmarkDefaultTypeInternal;
 extern LandmarkDefaultTypeInternal _Landmark_default_instance_;
@@ -104,6 +110,8 @@ namespace protobuf {
 template<> ::mediapipe::Detection* Arena::CreateMaybeMessage<::mediapipe::Detection>(Arena*);
 template<> ::mediapipe::DetectionList* Arena::CreateMaybeMessage<::mediapipe::DetectionList>(Arena*);
 template<> ::mediapipe::Detection_AssociatedDetection* Arena::CreateMaybeMessage<::mediapipe::Detection_AssociatedDetection>(Arena*);
+template<> ::mediapipe::HandTrackingCaptureRecord* Arena::CreateMaybeMessage<::mediapipe::HandTrackingCaptureRecord>(Arena*);
+template<> ::mediapipe::HandTrackingFeedback* Arena::CreateMaybeMessage<::mediapipe::HandTrackingFeedback>(Arena*);
 template<> ::mediapipe::Landmark* Arena::CreateMaybeMessage<::mediapipe::Landmark>(Arena*);
 template<> ::mediapipe::LandmarkList* Arena::CreateMaybeMessage<::mediapipe::LandmarkList>(Arena*);
 template<> ::mediapipe::LocationData* Arena::CreateMaybeMessage<::mediapipe::LocationData>(Arena*);
@@ -2658,6 +2666,27 @@ class WrapperHandTracking : public ::google::protobuf::Message /* @@protoc_inser
   ::mediapipe::DetectionList* mutable_detection();
   void set_allocated_detection(::mediapipe::DetectionList* detection);
 
+  // optional int64 timestamp_usec = 4;
+  bool has_timestamp_usec() const;
+  void clear_timestamp_usec();
+  static const int kTimestampUsecFieldNumber = 4;
+  ::google::protobuf::int64 timestamp_usec() const;
+  void set_timestamp_usec(::google::protobuf::int64 value);
+
+  // optional uint64 sequence_id = 5;
+  bool has_sequence_id() const;
+  void clear_sequence_id();
+  static const int kSequenceIdFieldNumber = 5;
+  ::google::protobuf::uint64 sequence_id() const;
+  void set_sequence_id(::google::protobuf::uint64 value);
+
+  // optional int64 send_time_usec = 6;
+  bool has_send_time_usec() const;
+  void clear_send_time_usec();
+  static const int kSendTimeUsecFieldNumber = 6;
+  ::google::protobuf::int64 send_time_usec() const;
+  void set_send_time_usec(::google::protobuf::int64 value);
+
   // @@protoc_insertion_point(class_scope:mediapipe.WrapperHandTracking)
  private:
   void set_has_landmarks();
@@ -2666,6 +2695,12 @@ class WrapperHandTracking : public ::google::protobuf::Message /* @@protoc_inser
   void clear_has_rect();
   void set_has_detection();
   void clear_has_detection();
+  void set_has_timestamp_usec();
+  void clear_has_timestamp_usec();
+  void set_has_sequence_id();
+  void clear_has_sequence_id();
+  void set_has_send_time_usec();
+  void clear_has_send_time_usec();
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::internal::HasBits<1> _has_bits_;
@@ -2673,6 +2708,312 @@ class WrapperHandTracking : public ::google::protobuf::Message /* @@protoc_inser
   ::mediapipe::NormalizedLandmarkList* landmarks_;
   ::mediapipe::NormalizedRect* rect_;
   ::mediapipe::DetectionList* detection_;
+  ::google::protobuf::int64 timestamp_usec_;
+  ::google::protobuf::uint64 sequence_id_;
+  ::google::protobuf::int64 send_time_usec_;
+  friend struct ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::TableStruct;
+};
+// -------------------------------------------------------------------
+
+class HandTrackingCaptureRecord : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:mediapipe.HandTrackingCaptureRecord) */ {
+ public:
+  HandTrackingCaptureRecord();
+  virtual ~HandTrackingCaptureRecord();
+
+  HandTrackingCaptureRecord(const HandTrackingCaptureRecord& from);
+
+  inline HandTrackingCaptureRecord& operator=(const HandTrackingCaptureRecord& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  HandTrackingCaptureRecord(HandTrackingCaptureRecord&& from) noexcept
+    : HandTrackingCaptureRecord() {
+    *this = ::std::move(from);
+  }
+
+  inline HandTrackingCaptureRecord& operator=(HandTrackingCaptureRecord&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields();
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const HandTrackingCaptureRecord& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const HandTrackingCaptureRecord* internal_default_instance() {
+    return reinterpret_cast<const HandTrackingCaptureRecord*>(
+               &_HandTrackingCaptureRecord_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    17;
+
+  void Swap(HandTrackingCaptureRecord* other);
+  friend void swap(HandTrackingCaptureRecord& a, HandTrackingCaptureRecord& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline HandTrackingCaptureRecord* New() const final {
+    return CreateMaybeMessage<HandTrackingCaptureRecord>(NULL);
+  }
+
+  HandTrackingCaptureRecord* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<HandTrackingCaptureRecord>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const HandTrackingCaptureRecord& from);
+  void MergeFrom(const HandTrackingCaptureRecord& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HandTrackingCaptureRecord* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional .mediapipe.WrapperHandTracking frame = 3;
+  bool has_frame() const;
+  void clear_frame();
+  static const int kFrameFieldNumber = 3;
+  private:
+  const ::mediapipe::WrapperHandTracking& _internal_frame() const;
+  public:
+  const ::mediapipe::WrapperHandTracking& frame() const;
+  ::mediapipe::WrapperHandTracking* release_frame();
+  ::mediapipe::WrapperHandTracking* mutable_frame();
+  void set_allocated_frame(::mediapipe::WrapperHandTracking* frame);
+
+  // optional int64 receive_usec = 1;
+  bool has_receive_usec() const;
+  void clear_receive_usec();
+  static const int kReceiveUsecFieldNumber = 1;
+  ::google::protobuf::int64 receive_usec() const;
+  void set_receive_usec(::google::protobuf::int64 value);
+
+  // optional int64 receive_wall_usec = 4;
+  bool has_receive_wall_usec() const;
+  void clear_receive_wall_usec();
+  static const int kReceiveWallUsecFieldNumber = 4;
+  ::google::protobuf::int64 receive_wall_usec() const;
+  void set_receive_wall_usec(::google::protobuf::int64 value);
+
+  // optional int32 source = 2;
+  bool has_source() const;
+  void clear_source();
+  static const int kSourceFieldNumber = 2;
+  ::google::protobuf::int32 source() const;
+  void set_source(::google::protobuf::int32 value);
+
+  // @@protoc_insertion_point(class_scope:mediapipe.HandTrackingCaptureRecord)
+ private:
+  void set_has_receive_usec();
+  void clear_has_receive_usec();
+  void set_has_source();
+  void clear_has_source();
+  void set_has_frame();
+  void clear_has_frame();
+  void set_has_receive_wall_usec();
+  void clear_has_receive_wall_usec();
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::internal::HasBits<1> _has_bits_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  ::mediapipe::WrapperHandTracking* frame_;
+  ::google::protobuf::int64 receive_usec_;
+  ::google::protobuf::int64 receive_wall_usec_;
+  ::google::protobuf::int32 source_;
+  friend struct ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::TableStruct;
+};
+// -------------------------------------------------------------------
+
+class HandTrackingFeedback : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:mediapipe.HandTrackingFeedback) */ {
+ public:
+  HandTrackingFeedback();
+  virtual ~HandTrackingFeedback();
+
+  HandTrackingFeedback(const HandTrackingFeedback& from);
+
+  inline HandTrackingFeedback& operator=(const HandTrackingFeedback& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  HandTrackingFeedback(HandTrackingFeedback&& from) noexcept
+    : HandTrackingFeedback() {
+    *this = ::std::move(from);
+  }
+
+  inline HandTrackingFeedback& operator=(HandTrackingFeedback&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields();
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const HandTrackingFeedback& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const HandTrackingFeedback* internal_default_instance() {
+    return reinterpret_cast<const HandTrackingFeedback*>(
+               &_HandTrackingFeedback_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    18;
+
+  void Swap(HandTrackingFeedback* other);
+  friend void swap(HandTrackingFeedback& a, HandTrackingFeedback& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline HandTrackingFeedback* New() const final {
+    return CreateMaybeMessage<HandTrackingFeedback>(NULL);
+  }
+
+  HandTrackingFeedback* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<HandTrackingFeedback>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const HandTrackingFeedback& from);
+  void MergeFrom(const HandTrackingFeedback& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HandTrackingFeedback* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional float received_per_sec = 1;
+  bool has_received_per_sec() const;
+  void clear_received_per_sec();
+  static const int kReceivedPerSecFieldNumber = 1;
+  float received_per_sec() const;
+  void set_received_per_sec(float value);
+
+  // optional float consumed_per_sec = 2;
+  bool has_consumed_per_sec() const;
+  void clear_consumed_per_sec();
+  static const int kConsumedPerSecFieldNumber = 2;
+  float consumed_per_sec() const;
+  void set_consumed_per_sec(float value);
+
+  // optional uint32 queue_depth = 3;
+  bool has_queue_depth() const;
+  void clear_queue_depth();
+  static const int kQueueDepthFieldNumber = 3;
+  ::google::protobuf::uint32 queue_depth() const;
+  void set_queue_depth(::google::protobuf::uint32 value);
+
+  // optional float loss_percent = 4;
+  bool has_loss_percent() const;
+  void clear_loss_percent();
+  static const int kLossPercentFieldNumber = 4;
+  float loss_percent() const;
+  void set_loss_percent(float value);
+
+  // optional float datagrams_per_sec = 5;
+  bool has_datagrams_per_sec() const;
+  void clear_datagrams_per_sec();
+  static const int kDatagramsPerSecFieldNumber = 5;
+  float datagrams_per_sec() const;
+  void set_datagrams_per_sec(float value);
+
+  // @@protoc_insertion_point(class_scope:mediapipe.HandTrackingFeedback)
+ private:
+  void set_has_received_per_sec();
+  void clear_has_received_per_sec();
+  void set_has_consumed_per_sec();
+  void clear_has_consumed_per_sec();
+  void set_has_queue_depth();
+  void clear_has_queue_depth();
+  void set_has_loss_percent();
+  void clear_has_loss_percent();
+  void set_has_datagrams_per_sec();
+  void clear_has_datagrams_per_sec();
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::internal::HasBits<1> _has_bits_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  float received_per_sec_;
+  float consumed_per_sec_;
+  ::google::protobuf::uint32 queue_depth_;
+  float loss_percent_;
+  float datagrams_per_sec_;
   friend struct ::protobuf_mediapipe_2fframework_2fformats_2fwrapper_5fhand_5ftracking_2eproto::TableStruct;
 };
 // ===================================================================
@@ -4727,6 +5068,336 @@ inline void WrapperHandTracking::set_allocated_detection(::mediapipe::DetectionL
   // @@protoc_insertion_point(field_set_allocated:mediapipe.WrapperHandTracking.detection)
 }
 
+// optional int64 timestamp_usec = 4;
+inline bool WrapperHandTracking::has_timestamp_usec() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void WrapperHandTracking::set_has_timestamp_usec() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void WrapperHandTracking::clear_has_timestamp_usec() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void WrapperHandTracking::clear_timestamp_usec() {
+  timestamp_usec_ = GOOGLE_LONGLONG(0);
+  clear_has_timestamp_usec();
+}
+inline ::google::protobuf::int64 WrapperHandTracking::timestamp_usec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.WrapperHandTracking.timestamp_usec)
+  return timestamp_usec_;
+}
+inline void WrapperHandTracking::set_timestamp_usec(::google::protobuf::int64 value) {
+  set_has_timestamp_usec();
+  timestamp_usec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.WrapperHandTracking.timestamp_usec)
+}
+
+// optional uint64 sequence_id = 5;
+inline bool WrapperHandTracking::has_sequence_id() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void WrapperHandTracking::set_has_sequence_id() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void WrapperHandTracking::clear_has_sequence_id() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void WrapperHandTracking::clear_sequence_id() {
+  sequence_id_ = GOOGLE_ULONGLONG(0);
+  clear_has_sequence_id();
+}
+inline ::google::protobuf::uint64 WrapperHandTracking::sequence_id() const {
+  // @@protoc_insertion_point(field_get:mediapipe.WrapperHandTracking.sequence_id)
+  return sequence_id_;
+}
+inline void WrapperHandTracking::set_sequence_id(::google::protobuf::uint64 value) {
+  set_has_sequence_id();
+  sequence_id_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.WrapperHandTracking.sequence_id)
+}
+
+// optional int64 send_time_usec = 6;
+inline bool WrapperHandTracking::has_send_time_usec() const {
+  return (_has_bits_[0] & 0x00000020u) != 0;
+}
+inline void WrapperHandTracking::set_has_send_time_usec() {
+  _has_bits_[0] |= 0x00000020u;
+}
+inline void WrapperHandTracking::clear_has_send_time_usec() {
+  _has_bits_[0] &= ~0x00000020u;
+}
+inline void WrapperHandTracking::clear_send_time_usec() {
+  send_time_usec_ = GOOGLE_LONGLONG(0);
+  clear_has_send_time_usec();
+}
+inline ::google::protobuf::int64 WrapperHandTracking::send_time_usec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.WrapperHandTracking.send_time_usec)
+  return send_time_usec_;
+}
+inline void WrapperHandTracking::set_send_time_usec(::google::protobuf::int64 value) {
+  set_has_send_time_usec();
+  send_time_usec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.WrapperHandTracking.send_time_usec)
+}
+
+// -------------------------------------------------------------------
+
+// HandTrackingCaptureRecord
+
+// optional int64 receive_usec = 1;
+inline bool HandTrackingCaptureRecord::has_receive_usec() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void HandTrackingCaptureRecord::set_has_receive_usec() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void HandTrackingCaptureRecord::clear_has_receive_usec() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void HandTrackingCaptureRecord::clear_receive_usec() {
+  receive_usec_ = GOOGLE_LONGLONG(0);
+  clear_has_receive_usec();
+}
+inline ::google::protobuf::int64 HandTrackingCaptureRecord::receive_usec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingCaptureRecord.receive_usec)
+  return receive_usec_;
+}
+inline void HandTrackingCaptureRecord::set_receive_usec(::google::protobuf::int64 value) {
+  set_has_receive_usec();
+  receive_usec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingCaptureRecord.receive_usec)
+}
+
+// optional int32 source = 2;
+inline bool HandTrackingCaptureRecord::has_source() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void HandTrackingCaptureRecord::set_has_source() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void HandTrackingCaptureRecord::clear_has_source() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void HandTrackingCaptureRecord::clear_source() {
+  source_ = 0;
+  clear_has_source();
+}
+inline ::google::protobuf::int32 HandTrackingCaptureRecord::source() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingCaptureRecord.source)
+  return source_;
+}
+inline void HandTrackingCaptureRecord::set_source(::google::protobuf::int32 value) {
+  set_has_source();
+  source_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingCaptureRecord.source)
+}
+
+// optional .mediapipe.WrapperHandTracking frame = 3;
+inline bool HandTrackingCaptureRecord::has_frame() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void HandTrackingCaptureRecord::set_has_frame() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void HandTrackingCaptureRecord::clear_has_frame() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void HandTrackingCaptureRecord::clear_frame() {
+  if (frame_ != NULL) frame_->Clear();
+  clear_has_frame();
+}
+inline const ::mediapipe::WrapperHandTracking& HandTrackingCaptureRecord::_internal_frame() const {
+  return *frame_;
+}
+inline const ::mediapipe::WrapperHandTracking& HandTrackingCaptureRecord::frame() const {
+  const ::mediapipe::WrapperHandTracking* p = frame_;
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingCaptureRecord.frame)
+  return p != NULL ? *p : *reinterpret_cast<const ::mediapipe::WrapperHandTracking*>(
+      &::mediapipe::_WrapperHandTracking_default_instance_);
+}
+inline ::mediapipe::WrapperHandTracking* HandTrackingCaptureRecord::release_frame() {
+  // @@protoc_insertion_point(field_release:mediapipe.HandTrackingCaptureRecord.frame)
+  clear_has_frame();
+  ::mediapipe::WrapperHandTracking* temp = frame_;
+  frame_ = NULL;
+  return temp;
+}
+inline ::mediapipe::WrapperHandTracking* HandTrackingCaptureRecord::mutable_frame() {
+  set_has_frame();
+  if (frame_ == NULL) {
+    auto* p = CreateMaybeMessage<::mediapipe::WrapperHandTracking>(GetArenaNoVirtual());
+    frame_ = p;
+  }
+  // @@protoc_insertion_point(field_mutable:mediapipe.HandTrackingCaptureRecord.frame)
+  return frame_;
+}
+inline void HandTrackingCaptureRecord::set_allocated_frame(::mediapipe::WrapperHandTracking* frame) {
+  ::google::protobuf::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == NULL) {
+    delete frame_;
+  }
+  if (frame) {
+    ::google::protobuf::Arena* submessage_arena = NULL;
+    if (message_arena != submessage_arena) {
+      frame = ::google::protobuf::internal::GetOwnedMessage(
+          message_arena, frame, submessage_arena);
+    }
+    set_has_frame();
+  } else {
+    clear_has_frame();
+  }
+  frame_ = frame;
+  // @@protoc_insertion_point(field_set_allocated:mediapipe.HandTrackingCaptureRecord.frame)
+}
+
+// optional int64 receive_wall_usec = 4;
+inline bool HandTrackingCaptureRecord::has_receive_wall_usec() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void HandTrackingCaptureRecord::set_has_receive_wall_usec() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void HandTrackingCaptureRecord::clear_has_receive_wall_usec() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void HandTrackingCaptureRecord::clear_receive_wall_usec() {
+  receive_wall_usec_ = GOOGLE_LONGLONG(0);
+  clear_has_receive_wall_usec();
+}
+inline ::google::protobuf::int64 HandTrackingCaptureRecord::receive_wall_usec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingCaptureRecord.receive_wall_usec)
+  return receive_wall_usec_;
+}
+inline void HandTrackingCaptureRecord::set_receive_wall_usec(::google::protobuf::int64 value) {
+  set_has_receive_wall_usec();
+  receive_wall_usec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingCaptureRecord.receive_wall_usec)
+}
+
+// -------------------------------------------------------------------
+
+// HandTrackingFeedback
+
+// optional float received_per_sec = 1;
+inline bool HandTrackingFeedback::has_received_per_sec() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void HandTrackingFeedback::set_has_received_per_sec() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void HandTrackingFeedback::clear_has_received_per_sec() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void HandTrackingFeedback::clear_received_per_sec() {
+  received_per_sec_ = 0;
+  clear_has_received_per_sec();
+}
+inline float HandTrackingFeedback::received_per_sec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingFeedback.received_per_sec)
+  return received_per_sec_;
+}
+inline void HandTrackingFeedback::set_received_per_sec(float value) {
+  set_has_received_per_sec();
+  received_per_sec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingFeedback.received_per_sec)
+}
+
+// optional float consumed_per_sec = 2;
+inline bool HandTrackingFeedback::has_consumed_per_sec() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void HandTrackingFeedback::set_has_consumed_per_sec() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void HandTrackingFeedback::clear_has_consumed_per_sec() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void HandTrackingFeedback::clear_consumed_per_sec() {
+  consumed_per_sec_ = 0;
+  clear_has_consumed_per_sec();
+}
+inline float HandTrackingFeedback::consumed_per_sec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingFeedback.consumed_per_sec)
+  return consumed_per_sec_;
+}
+inline void HandTrackingFeedback::set_consumed_per_sec(float value) {
+  set_has_consumed_per_sec();
+  consumed_per_sec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingFeedback.consumed_per_sec)
+}
+
+// optional uint32 queue_depth = 3;
+inline bool HandTrackingFeedback::has_queue_depth() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void HandTrackingFeedback::set_has_queue_depth() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void HandTrackingFeedback::clear_has_queue_depth() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void HandTrackingFeedback::clear_queue_depth() {
+  queue_depth_ = 0u;
+  clear_has_queue_depth();
+}
+inline ::google::protobuf::uint32 HandTrackingFeedback::queue_depth() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingFeedback.queue_depth)
+  return queue_depth_;
+}
+inline void HandTrackingFeedback::set_queue_depth(::google::protobuf::uint32 value) {
+  set_has_queue_depth();
+  queue_depth_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingFeedback.queue_depth)
+}
+
+// optional float loss_percent = 4;
+inline bool HandTrackingFeedback::has_loss_percent() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void HandTrackingFeedback::set_has_loss_percent() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void HandTrackingFeedback::clear_has_loss_percent() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void HandTrackingFeedback::clear_loss_percent() {
+  loss_percent_ = 0;
+  clear_has_loss_percent();
+}
+inline float HandTrackingFeedback::loss_percent() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingFeedback.loss_percent)
+  return loss_percent_;
+}
+inline void HandTrackingFeedback::set_loss_percent(float value) {
+  set_has_loss_percent();
+  loss_percent_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingFeedback.loss_percent)
+}
+
+// optional float datagrams_per_sec = 5;
+inline bool HandTrackingFeedback::has_datagrams_per_sec() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void HandTrackingFeedback::set_has_datagrams_per_sec() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void HandTrackingFeedback::clear_has_datagrams_per_sec() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void HandTrackingFeedback::clear_datagrams_per_sec() {
+  datagrams_per_sec_ = 0;
+  clear_has_datagrams_per_sec();
+}
+inline float HandTrackingFeedback::datagrams_per_sec() const {
+  // @@protoc_insertion_point(field_get:mediapipe.HandTrackingFeedback.datagrams_per_sec)
+  return datagrams_per_sec_;
+}
+inline void HandTrackingFeedback::set_datagrams_per_sec(float value) {
+  set_has_datagrams_per_sec();
+  datagrams_per_sec_ = value;
+  // @@protoc_insertion_point(field_set:mediapipe.HandTrackingFeedback.datagrams_per_sec)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -4762,6 +5433,10 @@ inline void WrapperHandTracking::set_allocated_detection(::mediapipe::DetectionL
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
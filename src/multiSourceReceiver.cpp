@@ -0,0 +1,323 @@
+#include "multiSourceReceiver.h"
+#include "handBatch.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+//--------------------------------------------------------------
+multiSourceReceiver::~multiSourceReceiver(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool multiSourceReceiver::setup(const std::vector<int>& ports){
+    close();
+    for (int port : ports){
+        if (!add_socket(port, "", "")){
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+bool multiSourceReceiver::setupMulticast(const std::string& group, int port, const std::string& interface_addr){
+    close();
+    if (!add_socket(port, group, interface_addr)){
+        close();
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void multiSourceReceiver::close(){
+    for (int fd : fds)
+        ::close(fd);
+    fds.clear();
+    ports.clear();
+    if (epoll_fd >= 0)
+        ::close(epoll_fd);
+    epoll_fd = -1;
+}
+
+//--------------------------------------------------------------
+void multiSourceReceiver::setBatch(int batch){
+    if (batch < 1) batch = 1;
+    if (batch > MULTI_SOURCE_MAX_BATCH) batch = MULTI_SOURCE_MAX_BATCH;
+    this->batch = batch;
+}
+
+//--------------------------------------------------------------
+bool multiSourceReceiver::add_socket(int port, const std::string& group, const std::string& interface_addr){
+    
+    if (fds.size() >= MULTI_SOURCE_MAX_SOCKETS){
+        error = "too many sockets";
+        return false;
+    }
+    if (epoll_fd < 0){
+        epoll_fd = epoll_create1(0);
+        if (epoll_fd < 0){
+            error = std::string("epoll_create1: ") + strerror(errno);
+            return false;
+        }
+        buffers.resize(MULTI_SOURCE_MAX_BATCH * MULTI_SOURCE_MAX_DATAGRAM);
+        sources.reserve(16);
+    }
+    
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd < 0){
+        error = std::string("socket: ") + strerror(errno);
+        return false;
+    }
+    
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    int buffer_size = 4 * 1024 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+    if (bind(fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0){
+        error = "bind to port " + std::to_string(port) + ": " + strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    
+    if (!group.empty()){
+        struct ip_mreq membership;
+        memset(&membership, 0, sizeof(membership));
+        if (inet_pton(AF_INET, group.c_str(), &membership.imr_multiaddr) != 1 ||
+            inet_pton(AF_INET, interface_addr.c_str(), &membership.imr_interface) != 1){
+            error = "bad multicast address: " + group + " on " + interface_addr;
+            ::close(fd);
+            return false;
+        }
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0){
+            error = "join " + group + ": " + strerror(errno);
+            ::close(fd);
+            return false;
+        }
+    }
+    
+    // level triggered: a socket we didn't fully drain shows up again next poll
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = (uint32_t)fds.size();
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0){
+        error = std::string("epoll_ctl: ") + strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    
+    fds.push_back(fd);
+    ports.push_back(port);
+    return true;
+}
+
+//--------------------------------------------------------------
+int multiSourceReceiver::poll(int timeout_ms, int max_datagrams){
+    
+    if (epoll_fd < 0)
+        return -1;
+    
+    struct epoll_event events[MULTI_SOURCE_MAX_SOCKETS];
+    int n = epoll_wait(epoll_fd, events, MULTI_SOURCE_MAX_SOCKETS, timeout_ms);
+    if (n < 0){
+        if (errno == EINTR)
+            return 0;
+        error = std::string("epoll_wait: ") + strerror(errno);
+        return -1;
+    }
+    
+    int ready[MULTI_SOURCE_MAX_SOCKETS];
+    int num_ready = 0;
+    for (int i=0; i<n; i++)
+        ready[num_ready++] = (int)events[i].data.u32;
+    
+    // round-robin over the ready sockets, one batch each, until all are
+    // drained; a socket that returns less than a full batch is empty
+    int total = 0;
+    while (num_ready > 0 && total < max_datagrams){
+        int kept = 0;
+        for (int i=0; i<num_ready && total < max_datagrams; i++){
+            int budget = std::min(batch, max_datagrams - total);
+            int got = read_socket(ready[i], budget);
+            if (got < 0)
+                return -1;
+            total += got;
+            if (got == budget)
+                ready[kept++] = ready[i];
+        }
+        num_ready = kept;
+    }
+    
+    expire_sources(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    return total;
+}
+
+//--------------------------------------------------------------
+int multiSourceReceiver::read_socket(int socket_index, int budget){
+    
+    struct mmsghdr messages[MULTI_SOURCE_MAX_BATCH];
+    struct iovec iovecs[MULTI_SOURCE_MAX_BATCH];
+    struct sockaddr_in senders[MULTI_SOURCE_MAX_BATCH];
+    memset(messages, 0, sizeof(messages[0]) * budget);
+    for (int i=0; i<budget; i++){
+        iovecs[i].iov_base = &buffers[i * MULTI_SOURCE_MAX_DATAGRAM];
+        iovecs[i].iov_len = MULTI_SOURCE_MAX_DATAGRAM;
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &senders[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+    }
+    
+    int n = recvmmsg(fds[socket_index], messages, budget, MSG_DONTWAIT, NULL);
+    if (n < 0){
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        error = std::string("recvmmsg: ") + strerror(errno);
+        return -1;
+    }
+    
+    int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t now_wall = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    handBatchReader batch;
+    const char* frame;
+    int size;
+    for (int i=0; i<n; i++){
+        Source& source = find_source(senders[i].sin_addr.s_addr, senders[i].sin_port, ports[socket_index], now);
+        
+        if (messages[i].msg_hdr.msg_flags & MSG_TRUNC){
+            source.parse_failures++;
+            continue;
+        }
+        // a batching sender packs several frames into one datagram
+        batch.reset(&buffers[i * MULTI_SOURCE_MAX_DATAGRAM], (int)messages[i].msg_len);
+        while (batch.next(frame, size)){
+            if (!decode_hand_frame(frame, size, wrapper, scratch)){
+                source.parse_failures++;
+                continue;
+            }
+            if (capture)
+                capture->write(wrapper, now, now_wall, source.id);
+            scratch.source = source.id;
+            scratch.receive_usec = now;
+            if (!source.stats.record(scratch, now, now_wall))
+                continue; // duplicate
+            
+            // a full ring drops this source's oldest frame, never another's
+            if (source.count == MULTI_SOURCE_RING_SIZE){
+                source.head = (source.head + 1) % MULTI_SOURCE_RING_SIZE;
+                source.count--;
+                source.overwritten++;
+            }
+            source.ring[(source.head + source.count) % MULTI_SOURCE_RING_SIZE] = scratch;
+            source.count++;
+            source.latest = scratch;
+            source.has_latest = true;
+        }
+    }
+    return n;
+}
+
+//--------------------------------------------------------------
+multiSourceReceiver::Source& multiSourceReceiver::find_source(uint32_t addr, uint16_t sender_port, int local_port, int64_t now_usec){
+    
+    Source* slot = nullptr;
+    for (auto& source : sources){
+        if (source.active && source.addr == addr && source.sender_port == sender_port && source.local_port == local_port){
+            source.last_receive_usec = now_usec;
+            return source;
+        }
+        if (!source.active && !slot)
+            slot = &source;
+    }
+    
+    // first datagram from this sender: an expired slot, a new one, or the
+    // one quiet the longest
+    if (!slot && sources.size() < MULTI_SOURCE_MAX_SOURCES){
+        sources.emplace_back();
+        slot = &sources.back();
+        slot->id = (int)sources.size() - 1;
+    }
+    if (!slot){
+        slot = &*std::min_element(sources.begin(), sources.end(), [](const Source& a, const Source& b){
+            return a.last_receive_usec < b.last_receive_usec;
+        });
+    }
+    int id = slot->id;
+    *slot = Source();
+    
+    Source& source = *slot;
+    source.id = id;
+    source.active = true;
+    source.last_receive_usec = now_usec;
+    source.addr = addr;
+    source.sender_port = sender_port;
+    source.local_port = local_port;
+    
+    char ip[INET_ADDRSTRLEN];
+    struct in_addr in;
+    in.s_addr = addr;
+    inet_ntop(AF_INET, &in, ip, sizeof(ip));
+    source.name = std::string(ip) + ":" + std::to_string(ntohs(sender_port)) + " -> " + std::to_string(local_port);
+    return source;
+}
+
+//--------------------------------------------------------------
+void multiSourceReceiver::expire_sources(int64_t now_usec){
+    
+    for (auto& source : sources){
+        if (source.active && now_usec - source.last_receive_usec > MULTI_SOURCE_IDLE_USEC){
+            source.active = false;
+            source.count = 0;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+int multiSourceReceiver::getNumActiveSources() const{
+    
+    int n = 0;
+    for (auto& source : sources)
+        n += source.active;
+    return n;
+}
+
+//--------------------------------------------------------------
+bool multiSourceReceiver::next(HandFrame& frame){
+    
+    int n = (int)sources.size();
+    for (int k=0; k<n; k++){
+        Source& source = sources[(next_source + k) % n];
+        if (source.count > 0){
+            frame = source.ring[source.head];
+            source.head = (source.head + 1) % MULTI_SOURCE_RING_SIZE;
+            source.count--;
+            next_source = (source.id + 1) % n;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
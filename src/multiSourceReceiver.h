@@ -0,0 +1,106 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "handFrame.h"
+#include "receiverStats.h"
+#include "handCapture.h"
+#include "wrapper_hand_tracking.pb.h"
+
+/**
+ Receives hand tracking streams from several MediaPipe senders at once.
+ 
+ Listens on a list of ports, or on one multicast group, and services every
+ socket from a single thread with epoll. Each sender (identified by its
+ address and the port it sent to) becomes a Source with its own ring of
+ decoded frames and its own receiverStats, so a busy sender can only
+ overwrite its own frames.
+ 
+ Reading is fair: each round takes at most `batch` datagrams from a ready
+ socket before moving to the next one, and next() hands frames out
+ round-robin across sources.
+ 
+ At most MULTI_SOURCE_MAX_SOURCES senders are tracked. One that has been
+ quiet for MULTI_SOURCE_IDLE_USEC is dropped, and its slot (and id) goes
+ to the next new sender; when every slot is busy, the longest quiet
+ sender makes room. So a restarting sender or a stray datagram can't grow
+ the list forever.
+ 
+ Linux only.
+ */
+
+#define MULTI_SOURCE_RING_SIZE 64
+#define MULTI_SOURCE_MAX_SOCKETS 32
+#define MULTI_SOURCE_MAX_BATCH 32
+#define MULTI_SOURCE_MAX_DATAGRAM 9216
+#define MULTI_SOURCE_MAX_SOURCES 64
+#define MULTI_SOURCE_IDLE_USEC 10000000
+
+class multiSourceReceiver{
+
+    public:
+        struct Source{
+            int id = 0;
+            std::string name;           // "ip:port -> local port"
+            uint32_t addr = 0;          // sender address and port (network order)
+            uint16_t sender_port = 0;
+            int local_port = 0;
+            bool active = false;        // false once expired, until the slot is reused
+            int64_t last_receive_usec = 0;
+        
+            HandFrame ring[MULTI_SOURCE_RING_SIZE];
+            int head = 0;
+            int count = 0;
+            uint64_t overwritten = 0;   // frames dropped because the ring was full
+            uint64_t parse_failures = 0;
+        
+            bool has_latest = false;
+            HandFrame latest;
+            receiverStats stats;
+        };
+    
+        ~multiSourceReceiver();
+    
+        bool setup(const std::vector<int>& ports);
+        bool setupMulticast(const std::string& group, int port, const std::string& interface_addr = "0.0.0.0");
+        void close();
+    
+        // datagrams taken from one socket before moving on to the next
+        void setBatch(int batch);
+        // record every decoded frame, tagged with its source id (not owned)
+        void setCapture(handCaptureWriter* writer){ capture = writer; }
+    
+        // wait up to timeout_ms for data, then read and decode until every
+        // socket is drained (or max_datagrams were read). Returns the number
+        // of datagrams read, or -1 on error.
+        int poll(int timeout_ms, int max_datagrams = 100000);
+    
+        // oldest unread frame, taking sources in turn
+        bool next(HandFrame& frame);
+    
+        // slots, including expired ones (see Source::active)
+        int getNumSources() const { return (int)sources.size(); }
+        int getNumActiveSources() const;
+        Source& getSource(int i) { return sources[i]; }
+        const std::string& getError() const { return error; }
+    
+    private:
+        bool add_socket(int port, const std::string& group, const std::string& interface_addr);
+        int read_socket(int socket_index, int budget);
+        Source& find_source(uint32_t addr, uint16_t sender_port, int local_port, int64_t now_usec);
+        void expire_sources(int64_t now_usec);
+    
+        int epoll_fd = -1;
+        std::vector<int> fds;
+        std::vector<int> ports;
+        std::vector<Source> sources;
+        int next_source = 0;
+        int batch = 8;
+        handCaptureWriter* capture = nullptr;
+    
+        // scratch space reused for every read
+        std::vector<char> buffers;
+        ::mediapipe::WrapperHandTracking wrapper;
+        HandFrame scratch;
+    
+        std::string error;
+};
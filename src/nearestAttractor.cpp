@@ -0,0 +1,132 @@
+#include "nearestAttractor.h"
+#include <cfloat>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NEAREST_ATTRACTOR_X86 1
+#include <immintrin.h>
+#endif
+
+//--------------------------------------------------------------
+void find_nearest_attractors_scalar(const float* px, const float* py, int n,
+                                    const float* ax, const float* ay, int num_attractors,
+                                    int* closest, float* dist_sq){
+    for (int i=0; i<n; i++){
+        int best = 0;
+        float best_d = FLT_MAX;
+        for (int j=0; j<num_attractors; j++){
+            float dx = ax[j] - px[i];
+            float dy = ay[j] - py[i];
+            float d = dx * dx + dy * dy;
+            if (d < best_d){
+                best_d = d;
+                best = j;
+            }
+        }
+        closest[i] = best;
+        dist_sq[i] = best_d;
+    }
+}
+
+#ifdef NEAREST_ATTRACTOR_X86
+
+//--------------------------------------------------------------
+__attribute__((target("sse2")))
+static void find_nearest_attractors_sse2(const float* px, const float* py, int n,
+                                         const float* ax, const float* ay, int num_attractors,
+                                         int* closest, float* dist_sq){
+    int i = 0;
+    for (; i + 4 <= n; i += 4){
+        __m128 x = _mm_loadu_ps(px + i);
+        __m128 y = _mm_loadu_ps(py + i);
+        __m128 best_d = _mm_set1_ps(FLT_MAX);
+        __m128i best = _mm_setzero_si128();
+        for (int j=0; j<num_attractors; j++){
+            __m128 dx = _mm_sub_ps(_mm_set1_ps(ax[j]), x);
+            __m128 dy = _mm_sub_ps(_mm_set1_ps(ay[j]), y);
+            __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            
+            // strictly closer only, so ties keep the first attractor like the scalar loop
+            __m128i closer = _mm_castps_si128(_mm_cmplt_ps(d, best_d));
+            best_d = _mm_min_ps(d, best_d);
+            best = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(j)), _mm_andnot_si128(closer, best));
+        }
+        _mm_storeu_si128((__m128i*)(closest + i), best);
+        _mm_storeu_ps(dist_sq + i, best_d);
+    }
+    find_nearest_attractors_scalar(px + i, py + i, n - i, ax, ay, num_attractors, closest + i, dist_sq + i);
+}
+
+//--------------------------------------------------------------
+__attribute__((target("avx2")))
+static void find_nearest_attractors_avx2(const float* px, const float* py, int n,
+                                         const float* ax, const float* ay, int num_attractors,
+                                         int* closest, float* dist_sq){
+    int i = 0;
+    for (; i + 8 <= n; i += 8){
+        __m256 x = _mm256_loadu_ps(px + i);
+        __m256 y = _mm256_loadu_ps(py + i);
+        __m256 best_d = _mm256_set1_ps(FLT_MAX);
+        __m256 best = _mm256_setzero_ps();     // indices, kept as int bits in a float register
+        for (int j=0; j<num_attractors; j++){
+            __m256 dx = _mm256_sub_ps(_mm256_set1_ps(ax[j]), x);
+            __m256 dy = _mm256_sub_ps(_mm256_set1_ps(ay[j]), y);
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            
+            __m256 closer = _mm256_cmp_ps(d, best_d, _CMP_LT_OQ);
+            best_d = _mm256_min_ps(d, best_d);
+            best = _mm256_blendv_ps(best, _mm256_castsi256_ps(_mm256_set1_epi32(j)), closer);
+        }
+        _mm256_storeu_si256((__m256i*)(closest + i), _mm256_castps_si256(best));
+        _mm256_storeu_ps(dist_sq + i, best_d);
+    }
+    // leave the upper halves clean, or the SSE code that follows (ours, or
+    // libm in the caller) pays for AVX/SSE transitions
+    _mm256_zeroupper();
+    find_nearest_attractors_sse2(px + i, py + i, n - i, ax, ay, num_attractors, closest + i, dist_sq + i);
+}
+
+#endif
+
+//--------------------------------------------------------------
+static nearestAttractorKernel detect_kernel(){
+#ifdef NEAREST_ATTRACTOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return NEAREST_ATTRACTOR_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return NEAREST_ATTRACTOR_SSE2;
+#endif
+    return NEAREST_ATTRACTOR_SCALAR;
+}
+
+static nearestAttractorKernel best_kernel = detect_kernel();
+static nearestAttractorKernel kernel = best_kernel;
+
+//--------------------------------------------------------------
+nearestAttractorKernel get_nearest_attractor_kernel(){
+    return kernel;
+}
+
+//--------------------------------------------------------------
+void set_nearest_attractor_kernel(nearestAttractorKernel k){
+    kernel = k <= best_kernel ? k : NEAREST_ATTRACTOR_SCALAR;
+}
+
+//--------------------------------------------------------------
+void find_nearest_attractors(const float* px, const float* py, int n,
+                             const float* ax, const float* ay, int num_attractors,
+                             int* closest, float* dist_sq){
+    switch (kernel){
+#ifdef NEAREST_ATTRACTOR_X86
+        case NEAREST_ATTRACTOR_AVX2:
+            find_nearest_attractors_avx2(px, py, n, ax, ay, num_attractors, closest, dist_sq);
+            return;
+        case NEAREST_ATTRACTOR_SSE2:
+            find_nearest_attractors_sse2(px, py, n, ax, ay, num_attractors, closest, dist_sq);
+            return;
+#endif
+        default:
+            find_nearest_attractors_scalar(px, py, n, ax, ay, num_attractors, closest, dist_sq);
+            return;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ Finds the closest attraction point for a batch of particles.
+ 
+ For each particle i, writes the index of the nearest attractor to
+ closest[i] and the squared distance to it to dist_sq[i]. Positions and
+ attractors are passed as separate x / y arrays.
+ 
+ On x86 the work is done 8 particles at a time with AVX2, or 4 at a time
+ with SSE2, picked at runtime from what the CPU supports; everything else
+ uses the plain loop.
+ */
+
+enum nearestAttractorKernel{
+    NEAREST_ATTRACTOR_SCALAR = 0,
+    NEAREST_ATTRACTOR_SSE2,
+    NEAREST_ATTRACTOR_AVX2
+};
+
+void find_nearest_attractors(const float* px, const float* py, int n,
+                             const float* ax, const float* ay, int num_attractors,
+                             int* closest, float* dist_sq);
+
+// the kernel find_nearest_attractors() will use on this machine
+nearestAttractorKernel get_nearest_attractor_kernel();
+
+// force a kernel (e.g. to compare them); falls back to scalar if unsupported
+void set_nearest_attractor_kernel(nearestAttractorKernel kernel);
+
+// run one specific kernel, for benchmarking
+void find_nearest_attractors_scalar(const float* px, const float* py, int n,
+                                    const float* ax, const float* ay, int num_attractors,
+                                    int* closest, float* dist_sq);
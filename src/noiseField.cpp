@@ -0,0 +1,62 @@
+#include "noiseField.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+//--------------------------------------------------------------
+static inline float fade(float t){
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+//--------------------------------------------------------------
+void noiseField::setup(int size, int cells, uint32_t seed){
+
+    shift = 0;
+    while ((1 << shift) < size)
+        shift++;
+    size = 1 << shift;
+    mask = size - 1;
+    cells = std::max(1, std::min(cells, size));
+    texels_per_cell = (float)size / cells;
+
+    // one random unit gradient per lattice point, wrapping at `cells`
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> angle(0, 6.2831853f);
+    std::vector<float> gx(cells * cells), gy(cells * cells);
+    for (int i=0; i<cells * cells; i++){
+        float a = angle(rng);
+        gx[i] = cosf(a);
+        gy[i] = sinf(a);
+    }
+
+    texels.resize(size * size);
+    float max_abs = 0;
+    for (int y=0; y<size; y++){
+        for (int x=0; x<size; x++){
+            float px = x / texels_per_cell;
+            float py = y / texels_per_cell;
+            int cx = (int)px, cy = (int)py;
+            float fx = px - cx, fy = py - cy;
+
+            float dots[4];
+            for (int c=0; c<4; c++){
+                int ox = c & 1, oy = c >> 1;
+                int g = ((cy + oy) % cells) * cells + (cx + ox) % cells;
+                dots[c] = gx[g] * (fx - ox) + gy[g] * (fy - oy);
+            }
+            float u = fade(fx), v = fade(fy);
+            float a = dots[0] + (dots[1] - dots[0]) * u;
+            float b = dots[2] + (dots[3] - dots[2]) * u;
+            float n = a + (b - a) * v;
+
+            texels[(y << shift) + x] = n;
+            max_abs = std::max(max_abs, fabsf(n));
+        }
+    }
+
+    // stretch to the same [-1, 1] range as ofSignedNoise
+    if (max_abs > 0){
+        for (auto& t : texels)
+            t /= max_abs;
+    }
+}
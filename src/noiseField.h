@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ Precomputed, tiling 2d gradient noise for the particle forces.
+
+ setup() evaluates Perlin noise once on a size x size grid of texels that
+ wraps around at the edges; sample() is then a bilinear lookup, a handful of
+ multiply-adds instead of a full noise evaluation per call. Coordinates are
+ in noise cells like ofSignedNoise (about one bump per unit), values are in
+ [-1, 1], and the field repeats every `cells` units.
+ */
+
+class noiseField{
+
+    public:
+        // size is rounded up to a power of two, and should be a multiple of cells
+        void setup(int size = 256, int cells = 32, uint32_t seed = 1);
+        bool isSetup() const { return !texels.empty(); }
+
+        inline float sample(float x, float y) const {
+            float fx = x * texels_per_cell;
+            float fy = y * texels_per_cell;
+            int ix = (int)fx;
+            int iy = (int)fy;
+            ix -= fx < ix;              // floor, without the libm call
+            iy -= fy < iy;
+            float tx = fx - ix;
+            float ty = fy - iy;
+
+            int x0 = ix & mask, x1 = (ix + 1) & mask;
+            int y0 = (iy & mask) << shift, y1 = ((iy + 1) & mask) << shift;
+            const float* t = texels.data();
+            float a = t[y0 + x0] + (t[y0 + x1] - t[y0 + x0]) * tx;
+            float b = t[y1 + x0] + (t[y1 + x1] - t[y1 + x0]) * tx;
+            return a + (b - a) * ty;
+        }
+
+    private:
+        std::vector<float> texels;
+        float texels_per_cell = 8;
+        int mask = 255;
+        int shift = 8;
+};
@@ -4,6 +4,8 @@
 void ofApp::setup(){
     
     ofSetWindowTitle("MediaPipe <--> openFrameworks Example");
+    handTrace::setProcessName("receiver (openFrameworks)");
+    HAND_TRACE_THREAD("main");
     
     // create the socket and bind to port 8080
     ofxUDPSettings settings;
@@ -19,8 +21,9 @@ void ofApp::setup(){
     
     
     // create an empty hand_pts list with the 21 hand points
-    for (int i=0; i<21; i++)
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++)
         hand_pts.push_back(ofVec3f());
+    hand_renderer.setup(HAND_TOPOLOGY);
     
     ofSetRectMode(OF_RECTMODE_CENTER);
     ofSetBackgroundColor(255);
@@ -28,50 +31,202 @@ void ofApp::setup(){
     
     // particle system interacting with hand
     setup_particle_system();
+    
+    setup_metrics();
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
     
-    // check for incoming messages
+    HAND_TRACE_SCOPE("update");
+    metricTimer update_timer(metric_stage_update);
+    
+    // check for incoming messages, draining everything that arrived since
+    // the last frame so we never fall behind the sender
+    int64_t now = ofGetElapsedTimeMicros();
+    int64_t now_wall = ofGetSystemTimeMicros();
     char udpMessage[100000];
-    auto n = udpConnection.Receive(udpMessage,100000);
-    if (n > 0){
-        
-        // accept the incoming proto
-        wrapper->Clear();
-        wrapper->ParseFromArray(udpMessage, udpConnection.GetReceiveBufferSize());
-        
-        // update the hand_pts list
-        for (int i=0; i<wrapper->landmarks().landmark_size(); i++){
-            auto& landmark = wrapper->landmarks().landmark(i);
-            hand_pts[i] = toOf(landmark.x(), landmark.y(), img_width, img_height);
-//            cout << "Landmark " << i << ": " << endl;
-//            cout << landmark.DebugString() << endl;
+    int datagrams = 0;
+    int frames = 0;
+    while (true){
+        int n;
+        {
+            HAND_TRACE_SCOPE("receive");
+            metricTimer timer(metric_stage_receive);
+            n = udpConnection.Receive(udpMessage,100000);
         }
-//        cout << wrapper->landmarks().DebugString() << endl;
-        
-        
-        // update the hand rectangle
-        if (wrapper->rect().x_center() != 0 && wrapper->rect().y_center() != 0){
+        if (n <= 0)
+            break;
+        // stamp each datagram as it's read, so the jitter and latency stats
+        // don't all collapse onto the start of the update
+        int64_t receive_usec = ofGetElapsedTimeMicros();
+        int64_t receive_wall_usec = ofGetSystemTimeMicros();
+        metric_datagrams.add();
+        metric_bytes.add(n);
+        datagrams++;
         
-            hand_rect.rect.position = toOf(wrapper->rect().x_center(), wrapper->rect().y_center(), img_width, img_height);
-            ofVec3f temp = toOf(wrapper->rect().width(), wrapper->rect().height(), img_width, img_height);
-            hand_rect.rect.width = temp.x;
-            hand_rect.rect.height = temp.y;
-            hand_rect.rotation = wrapper->rect().rotation();
-//            cout << wrapper->rect().DebugString() << endl;
+        // accept the incoming protos: one, or several packed into the
+        // datagram by a batching sender (see handBatch.h)
+        handBatchReader batch;
+        batch.reset(udpMessage, n);
+        const char* message;
+        int size;
+        while (batch.next(message, size)){
+            metric_frames.add();
+            frames++;
+            
+            // while replaying, live frames are dropped
+            if (capture_replayer.isOpen())
+                continue;
+            
+            bool ok;
+            {
+                HAND_TRACE_SCOPE("parse");
+                metricTimer timer(metric_parse);
+                ok = decode_hand_frame(message, size, *wrapper, hand_frame);
+            }
+            if (!ok){
+                metric_parse_failures.add();
+                continue;
+            }
+            if (capture_writer.isOpen())
+                capture_writer.write(*wrapper, receive_usec, receive_wall_usec);
+            receive_hand_frame(receive_usec, receive_wall_usec);
         }
     }
     
+    send_feedback(now, frames, datagrams);
+    
+    // replayed frames arrive with the times they were recorded at, moved onto our clock
+    while (capture_replayer.next(now, capture_record)){
+        to_hand_frame(capture_record.frame(), hand_frame);
+        receive_hand_frame(capture_record.receive_usec(), capture_record.has_receive_wall_usec() ? capture_record.receive_wall_usec() : now_wall);
+    }
+    
+    // pick the (interpolated) hand for this frame
+    if (use_jitter_buffer && jitter_buffer.sample(now, hand_frame))
+        apply_hand_frame(hand_frame);
+    
     // if we're swatting particles, update
-    if (show_particles)
+    if (show_particles){
+        metricTimer timer(metric_stage_particles);
         update_particle_system();
+    }
+    
+    metric_lost.set(receive_stats.getStats().lost);
+    metric_duplicates.set(receive_stats.getStats().duplicates);
+}
+
+//--------------------------------------------------------------
+void ofApp::receive_hand_frame(int64_t now, int64_t now_wall){
+    
+    hand_frame.receive_usec = now;
+    if (!receive_stats.record(hand_frame, now, now_wall))
+        return; // duplicate
+    {
+        HAND_TRACE_SCOPE("filter");
+        metricTimer timer(metric_filter);
+        if (!hand_filter.apply(hand_frame))
+            return; // late, the smoothed frames around it already cover it
+    }
+    
+    if (use_jitter_buffer)
+        jitter_buffer.push(hand_frame);
+    else
+        apply_hand_frame(hand_frame);
+}
+
+//--------------------------------------------------------------
+void ofApp::send_feedback(int64_t now, int frames, int datagrams){
+    
+    // every update renders a frame, so that's the rate we consume at
+    feedback.received(frames, datagrams);
+    feedback.consumed();
+    
+    // answer whoever is sending
+    if (datagrams > 0){
+        string host;
+        int port = 0;
+        if (udpConnection.GetRemoteAddr(host, port) && (host != feedback_host || port != feedback_port)){
+            ofxUDPSettings settings;
+            settings.sendTo(host, port);
+            settings.blocking = false;
+            feedback_connection.Close();
+            if (feedback_connection.Setup(settings)){
+                feedback_host = host;
+                feedback_port = port;
+            }
+        }
+    }
+    
+    auto& stats = receive_stats.getStats();
+    if (feedback.update(now, stats.received, stats.lost, feedback_datagram) && feedback_port != 0)
+        feedback_connection.Send(feedback_datagram.data(), feedback_datagram.size());
+}
+
+//--------------------------------------------------------------
+void ofApp::toggle_recording(){
+    
+    if (capture_writer.isOpen()){
+        capture_writer.close();
+        ofLogNotice("ofApp") << "recorded " << capture_writer.getNumRecords() << " frames";
+        return;
+    }
+    if (!capture_writer.open(ofToDataPath("hand_capture.pbd.gz"), true))
+        ofLogError("ofApp") << capture_writer.getError();
+}
+
+//--------------------------------------------------------------
+void ofApp::toggle_replay(){
+    
+    // the capture's sequence ids and timestamps have nothing to do with the
+    // live stream's, so start the stats and the buffer over either way
+    receive_stats.reset();
+    jitter_buffer.clear();
+    if (capture_replayer.isOpen()){
+        capture_replayer.close();
+        return;
+    }
+    capture_replayer.setLoop(true);
+    if (!capture_replayer.open(ofToDataPath("hand_capture.pbd.gz")))
+        ofLogError("ofApp") << "can't replay: " << (capture_replayer.getError().empty() ? "no frames recorded" : capture_replayer.getError());
+}
+
+//--------------------------------------------------------------
+void ofApp::write_trace(){
+    
+    std::string path = ofToDataPath("hand_trace_receiver.json");
+    if (!handTrace::isEnabled())
+        ofLogError("ofApp") << "tracing is off: build with HAND_TRACE defined";
+    else if (!handTrace::write(path))
+        ofLogError("ofApp") << "can't write " << path;
+    else
+        ofLogNotice("ofApp") << "wrote trace to " << path;
+}
 
+//--------------------------------------------------------------
+void ofApp::setup_metrics(){
+    
+    metrics.add(&metric_frames, "hand_receiver_frames", "Frames received, counting each one in a batch");
+    metrics.add(&metric_datagrams, "hand_receiver_datagrams", "Datagrams received");
+    metrics.add(&metric_bytes, "hand_receiver_bytes", "Bytes received");
+    metrics.add(&metric_parse_failures, "hand_receiver_parse_failures", "Frames that didn't parse");
+    metrics.add(&metric_lost, "hand_receiver_frames_lost", "Frames lost in transit, by sequence id");
+    metrics.add(&metric_duplicates, "hand_receiver_frames_duplicate", "Duplicate frames dropped");
+    metrics.add(&metric_parse, "hand_receiver_parse", "Time to parse one frame");
+    metrics.add(&metric_filter, "hand_receiver_filter", "Time to filter one frame");
+    metrics.add(&metric_stage_receive, "hand_receiver_stage", "Time per ofApp stage, per call", "stage=\"receive\"");
+    metrics.add(&metric_stage_particles, "hand_receiver_stage", "Time per ofApp stage, per call", "stage=\"particles\"");
+    metrics.add(&metric_stage_update, "hand_receiver_stage", "Time per ofApp stage, per call", "stage=\"update\"");
+    metrics.add(&metric_stage_draw, "hand_receiver_stage", "Time per ofApp stage, per call", "stage=\"draw\"");
+    if (!metrics.serveFile(ofToDataPath("hand_metrics.prom")))
+        ofLogError("ofApp") << metrics.getError();
 }
 
 //--------------------------------------------------------------
 void ofApp::draw(){
+    HAND_TRACE_SCOPE("draw");
+    metricTimer draw_timer(metric_stage_draw);
     ofBackground(225);
     
     draw_debug_hand();
@@ -83,9 +238,64 @@ void ofApp::draw(){
     ofPushStyle();
     ofSetColor(10);
     ofDrawBitmapString("Press 'SPACE' to push around some particles.", 15, ofGetHeight() - 35);
+    if (capture_writer.isOpen())
+        ofDrawBitmapString("Recording ('c'): " + ofToString(capture_writer.getNumRecords()) + " frames", 15, ofGetHeight() - 75);
+    else if (capture_replayer.isOpen())
+        ofDrawBitmapString("Replaying ('p'): " + ofToString(capture_replayer.getNumReplayed()) + " frames", 15, ofGetHeight() - 75);
+    string filter_names[] = {"off", "one euro", "kalman"};
+    ofDrawBitmapString("Landmark filter ('f'): " + filter_names[hand_filter.getMode()], 15, ofGetHeight() - 55);
+    if (use_jitter_buffer){
+        auto& stats = jitter_buffer.getStats();
+        ofDrawBitmapString("Jitter buffer ('j'): delay " + ofToString(stats.delay_usec / 1000) + "ms, " +
+                           ofToString(stats.buffered) + " buffered, " +
+                           ofToString(stats.underruns) + " underruns, " +
+                           ofToString(stats.frames_late) + " late", 15, ofGetHeight() - 15);
+    }
+    ofPopStyle();
+    
+    if (show_stats)
+        draw_stats_overlay();
+}
+
+//--------------------------------------------------------------
+void ofApp::draw_stats_overlay(){
+    
+    auto& stats = receive_stats.getStats();
+    
+    ofPushStyle();
+    ofSetColor(10);
+    int x = ofGetWidth() - 300;
+    int y = ofGetHeight() - 115;
+    ofDrawBitmapString("Receive stats ('s')", x, y);
+    ofDrawBitmapString("received:  " + ofToString(stats.received) + " / " + ofToString(stats.expected), x, y += 20);
+    ofDrawBitmapString("lost:      " + ofToString(stats.lost) + " (" + ofToString(stats.loss_percent, 2) + "%)", x, y += 20);
+    ofDrawBitmapString("reordered: " + ofToString(stats.reordered) + ", dup: " + ofToString(stats.duplicates), x, y += 20);
+    ofDrawBitmapString("jitter:    " + ofToString(stats.jitter_usec / 1000.0f, 2) + "ms", x, y += 20);
+    ofDrawBitmapString("latency:   " + ofToString(stats.latency_avg_usec / 1000.0f, 2) + "ms (" +
+                       ofToString(stats.latency_min_usec / 1000.0f, 1) + "-" +
+                       ofToString(stats.latency_max_usec / 1000.0f, 1) + ")", x, y += 20);
     ofPopStyle();
 }
 
+//--------------------------------------------------------------
+void ofApp::apply_hand_frame(const HandFrame& frame){
+    
+    // update the hand_pts list
+    for (int i=0; i<frame.num_landmarks; i++){
+        hand_pts[i] = toOf(frame.x[i], frame.y[i], img_width, img_height);
+    }
+    
+    // update the hand rectangle
+    if (frame.has_rect){
+        
+        hand_rect.rect.position = toOf(frame.rect_x_center, frame.rect_y_center, img_width, img_height);
+        ofVec3f temp = toOf(frame.rect_width, frame.rect_height, img_width, img_height);
+        hand_rect.rect.width = temp.x;
+        hand_rect.rect.height = temp.y;
+        hand_rect.rotation = frame.rect_rotation;
+    }
+}
+
 //--------------------------------------------------------------
 ofVec3f ofApp::toOf(float x, float y, int x_bounds, int y_bounds){
     
@@ -97,108 +307,12 @@ ofVec3f ofApp::toOf(float x, float y, int x_bounds, int y_bounds){
 void ofApp::draw_debug_hand(){
     
     
-    // Draw and Label the Hand Points
-    ofPushStyle();
-    ofFill();
-    for (int i=0; i<hand_pts.size(); i++){
-        ofSetColor(ofColor::black);
-        ofDrawBitmapString(ofToString(i), hand_pts[i].x+10, hand_pts[i].y+10);
-        ofSetColor(ofColor::cyan, 120);
-        ofDrawEllipse(hand_pts[i].x, hand_pts[i].y, 15, 15);
-    }
-    
-    
-    // Draw the Hand Skeleton
-    /** This is from /mediapipe/graphs/hand_tracking/sub_graphs/renderer_cpu.pbtxt
-
-     # Converts landmarks to drawing primitives for annotation overlay.
-     node {
-       calculator: "LandmarksToRenderDataCalculator"
-       input_stream: "NORM_LANDMARKS:landmarks"
-       output_stream: "RENDER_DATA:landmark_render_data"
-       node_options: {
-         [type.googleapis.com/mediapipe.LandmarksToRenderDataCalculatorOptions] {
-           landmark_connections: 0
-           landmark_connections: 1
-           landmark_connections: 1
-           landmark_connections: 2
-           landmark_connections: 2
-           landmark_connections: 3
-           landmark_connections: 3
-           landmark_connections: 4
-           landmark_connections: 0
-           landmark_connections: 5
-           landmark_connections: 5
-           landmark_connections: 6
-           landmark_connections: 6
-           landmark_connections: 7
-           landmark_connections: 7
-           landmark_connections: 8
-           landmark_connections: 5
-           landmark_connections: 9
-           landmark_connections: 9
-           landmark_connections: 10
-           landmark_connections: 10
-           landmark_connections: 11
-           landmark_connections: 11
-           landmark_connections: 12
-           landmark_connections: 9
-           landmark_connections: 13
-           landmark_connections: 13
-           landmark_connections: 14
-           landmark_connections: 14
-           landmark_connections: 15
-           landmark_connections: 15
-           landmark_connections: 16
-           landmark_connections: 13
-           landmark_connections: 17
-           landmark_connections: 0
-           landmark_connections: 17
-           landmark_connections: 17
-           landmark_connections: 18
-           landmark_connections: 18
-           landmark_connections: 19
-           landmark_connections: 19
-           landmark_connections: 20
-           landmark_color { r: 255 g: 0 b: 0 }
-           connection_color { r: 0 g: 255 b: 0 }
-           thickness: 4.0
-         }
-       }
-     }
-     */
-    ofSetColor(ofColor::magenta, 120);
-    ofSetLineWidth(3);
-    
-    ofDrawLine(hand_pts[0], hand_pts[1]);
-    ofDrawLine(hand_pts[1], hand_pts[2]);
-    ofDrawLine(hand_pts[2], hand_pts[3]);
-    ofDrawLine(hand_pts[3], hand_pts[4]);
-    
-    ofDrawLine(hand_pts[0], hand_pts[5]);
-    ofDrawLine(hand_pts[5], hand_pts[6]);
-    ofDrawLine(hand_pts[6], hand_pts[7]);
-    ofDrawLine(hand_pts[7], hand_pts[8]);
-    
-    ofDrawLine(hand_pts[5], hand_pts[9]);
-    ofDrawLine(hand_pts[9], hand_pts[10]);
-    ofDrawLine(hand_pts[10], hand_pts[11]);
-    ofDrawLine(hand_pts[11], hand_pts[12]);
-    
-    ofDrawLine(hand_pts[9], hand_pts[13]);
-    ofDrawLine(hand_pts[13], hand_pts[14]);
-    ofDrawLine(hand_pts[14], hand_pts[15]);
-    ofDrawLine(hand_pts[15], hand_pts[16]);
-    
-    ofDrawLine(hand_pts[13], hand_pts[17]);
-    
-    ofDrawLine(hand_pts[0], hand_pts[17]);
-    ofDrawLine(hand_pts[17], hand_pts[18]);
-    ofDrawLine(hand_pts[18], hand_pts[19]);
-    ofDrawLine(hand_pts[19], hand_pts[20]);
+    // Draw and Label the Hand Points, and the Hand Skeleton
+    hand_renderer.draw(hand_pts.data(), 1);
     
 
     // Draw the Hand Rectangle
+    ofPushStyle();
     ofSetLineWidth(1);
     ofSetColor(ofColor::orange);
     ofNoFill();
@@ -223,6 +337,13 @@ void ofApp::keyPressed(int key){
         case 'r':
             reset_particle_system();
             break;
+        case '+':
+        case '=':
+            resize_particle_system(min(num_particles * 2, max_particles));
+            break;
+        case '-':
+            resize_particle_system(max(num_particles / 2, 1));
+            break;
         case '0':
             currentMode = PARTICLE_MODE_ATTRACT;
             break;
@@ -232,6 +353,34 @@ void ofApp::keyPressed(int key){
         case '2':
             currentMode = PARTICLE_MODE_NEAREST_POINTS;
             break;
+        case 'f':
+            hand_filter.setMode((landmarkFilterMode)((hand_filter.getMode() + 1) % 3));
+            break;
+        case 's':
+            show_stats = !show_stats;
+            break;
+        case 'j':
+            use_jitter_buffer = !use_jitter_buffer;
+            jitter_buffer.clear();
+            break;
+        case 'm':
+            particle_renderer.setPersistentMapping(!particle_renderer.getPersistentMapping());
+            break;
+        case 't':
+            particle_sim.setThreaded(!particle_sim.isThreaded());
+            break;
+        case 'e':
+            use_emitters = !use_emitters;
+            break;
+        case 'c':
+            toggle_recording();
+            break;
+        case 'p':
+            toggle_replay();
+            break;
+        case 'T':
+            write_trace();
+            break;
         default:
             break;
     }
@@ -240,8 +389,13 @@ void ofApp::keyPressed(int key){
 //--------------------------------------------------------------
 void ofApp::setup_particle_system(){
 
-    int num = 1000;
-    p.assign(num, demoParticle());
+    particle_threads.setup();
+    particles.setThreadPool(&particle_threads);
+    // every slot '+' can ask for, up front
+    particles.setup(max_particles, num_emitted);
+    particles.setNumParticles(num_particles);
+    particle_renderer.setup(particles.capacity());
+    particle_sim.setup(&particles);
     currentMode = PARTICLE_MODE_NEAREST_POINTS;
 
     currentModeStr = "1 - PARTICLE_MODE_ATTRACT: attracts to mouse";
@@ -251,40 +405,75 @@ void ofApp::setup_particle_system(){
 
 //--------------------------------------------------------------
 void ofApp::update_particle_system(){
+    HAND_TRACE_SCOPE("particle update");
     // update attractionPoints
+    attract_x.resize(hand_pts.size());
+    attract_y.resize(hand_pts.size());
     for (int i=0; i<hand_pts.size(); i++){
-        attractPoints[i] = hand_pts[i];
+        attract_x[i] = hand_pts[i].x;
+        attract_y[i] = hand_pts[i].y;
     }
     
-    for(unsigned int i = 0; i < p.size(); i++){
-        p[i].setMode(currentMode);
-        p[i].setAttractPoints(&attractPoints);
-        p[i].update();
+    // read the window and mouse once for the whole frame (the simulation
+    // keeps its own clock)
+    ParticleFrameContext frame;
+    frame.mode = currentMode;
+    frame.target_x = ofGetMouseX();
+    frame.target_y = ofGetMouseY();
+    frame.width = ofGetWidth();
+    frame.height = ofGetHeight();
+    frame.attract_x = attract_x.data();
+    frame.attract_y = attract_y.data();
+    frame.num_attractors = attract_x.size();
+    
+    // spray from the fingertips
+    emitters.resize(use_emitters ? HAND_NUM_FINGERTIPS : 0);
+    for (int i=0; i<emitters.size(); i++){
+        emitters[i].x = hand_pts[HAND_FINGERTIPS[i]].x;
+        emitters[i].y = hand_pts[HAND_FINGERTIPS[i]].y;
     }
+    frame.emitters = emitters.data();
+    frame.num_emitters = emitters.size();
+    particle_sim.setFrame(frame);
+    particle_sim.update();
 }
 
 //--------------------------------------------------------------
 void ofApp::draw_particle_system(){
     
-    for(unsigned int i = 0; i < p.size(); i++){
-        p[i].draw();
+    switch (currentMode){
+        case PARTICLE_MODE_ATTRACT:
+            ofSetColor(255, 63, 180);
+            break;
+        case PARTICLE_MODE_REPEL:
+            ofSetColor(208, 255, 63);
+            break;
+        case PARTICLE_MODE_NOISE:
+            ofSetColor(99, 63, 255);
+            break;
+        case PARTICLE_MODE_NEAREST_POINTS:
+            ofSetColor(103, 160, 237);
+            break;
     }
+    
+    float radius = particles.scale * 4.0;
+    particle_renderer.draw(particle_sim.getX(), particle_sim.getY(), particle_sim.size(), radius);
 }
 
 //--------------------------------------------------------------
 void ofApp::reset_particle_system(){
 
-    //these are the attraction points used in the forth demo
-    attractPoints.clear();
-    for(int i = 0; i < hand_pts.size(); i++){
-        attractPoints.push_back( ofPoint( hand_pts[i].x, hand_pts[i].y ) );
-    }
-    
-    attractPointsWithMovement = attractPoints;
-    
-    for(unsigned int i = 0; i < p.size(); i++){
-        p[i].setMode(currentMode);
-        p[i].setAttractPoints(&attractPointsWithMovement);;
-        p[i].reset();
-    }
+    particle_sim.lock();
+    particles.reset(currentMode, ofGetWidth(), ofGetHeight());
+    particle_sim.unlock();
+}
+
+//--------------------------------------------------------------
+void ofApp::resize_particle_system(int num){
+
+    num_particles = num;
+    particle_sim.lock();
+    particles.setNumParticles(num_particles);
+    particles.reset(currentMode, ofGetWidth(), ofGetHeight());
+    particle_sim.unlock();
 }
@@ -3,7 +3,19 @@
 #include "ofMain.h"
 #include "ofxNetwork.h"
 #include "wrapper_hand_tracking.pb.h"
-#include "demoParticle.h"
+#include "handBackpressure.h"
+#include "handBatch.h"
+#include "handCapture.h"
+#include "handFrame.h"
+#include "handJitterBuffer.h"
+#include "handMetrics.h"
+#include "handTrace.h"
+#include "landmarkFilter.h"
+#include "receiverStats.h"
+#include "ParticleSystem.h"
+#include "particleRenderer.h"
+#include "particleSimulation.h"
+#include "skeletonRenderer.h"
 
 /**
     Example showing how to receive protobuf from separate app over UDP.
@@ -38,7 +50,62 @@ class ofApp : public ofBaseApp{
             float rotation = 0; // in radians
         };
         HandRect hand_rect;
+        landmarkFilter hand_filter;     // smooths landmarks as they arrive
+        void apply_hand_frame(const HandFrame& frame);
         void draw_debug_hand();
+        skeletonRenderer hand_renderer;     // points, labels and connections in a few draw calls
+    
+        // Smooth out uneven arrival: render the hand a little in the past,
+        // interpolating between buffered frames
+        bool use_jitter_buffer = true;
+        handJitterBuffer jitter_buffer;
+        HandFrame hand_frame;
+    
+        // Loss / reordering / jitter / latency of the incoming stream
+        receiverStats receive_stats;
+        bool show_stats = false;
+        void draw_stats_overlay();
+        void receive_hand_frame(int64_t now, int64_t now_wall);
+    
+        // Backpressure: a few times a second, tell the sender how many frames
+        // we get through and how many were waiting, so it can slow down when
+        // drawing can't keep up (see handBackpressure.h)
+        handFeedback feedback;
+        ofxUDPManager feedback_connection;
+        string feedback_host;
+        int feedback_port = 0;
+        string feedback_datagram;
+        void send_feedback(int64_t now, int frames, int datagrams);
+    
+        // 'c' records the incoming stream to data/hand_capture.pbd.gz, 'p' loops
+        // it back in place of the network, through the same path as live frames
+        handCaptureWriter capture_writer;
+        handCaptureReplayer capture_replayer;
+        ::mediapipe::HandTrackingCaptureRecord capture_record;
+        void toggle_recording();
+        void toggle_replay();
+    
+        // 'T' writes the spans recorded so far to data/hand_trace_receiver.json
+        // (needs a build with HAND_TRACE defined, see handTrace.h)
+        void write_trace();
+    
+        // Prometheus metrics, rewritten to data/hand_metrics.prom every second
+        // (see handMetrics.h). The registry comes after the metrics so it's
+        // destroyed, and its export thread stopped, first.
+        metricCounter metric_frames;
+        metricCounter metric_datagrams;
+        metricCounter metric_bytes;
+        metricCounter metric_parse_failures;
+        metricGauge metric_lost;
+        metricGauge metric_duplicates;
+        metricHistogram metric_parse;
+        metricHistogram metric_filter;
+        metricHistogram metric_stage_receive;
+        metricHistogram metric_stage_particles;
+        metricHistogram metric_stage_update;
+        metricHistogram metric_stage_draw;
+        handMetrics metrics;
+        void setup_metrics();
     
         // helper function to convert a normalized point to ofVec3f
         ofVec3f toOf(float x, float y, int x_bounds, int y_bounds);
@@ -51,11 +118,20 @@ class ofApp : public ofBaseApp{
         particleMode currentMode;
         string currentModeStr;
 
-        vector <demoParticle> p;
-        vector <ofPoint> attractPoints;
-        vector <ofPoint> attractPointsWithMovement;
+        int num_particles = 1000;       // '+' / '-' to double / halve
+        int max_particles = 1 << 20;    // allocated once in setup
+        int num_emitted = 4096;         // pool for particles sprayed from the fingertips
+        bool use_emitters = false;      // 'e'
+        vector <particleEmitter> emitters;
+        ParticleSystem particles;
+        threadPool particle_threads;    // one thread per core, joined every update
+        particleSimulation particle_sim;    // fixed 60Hz steps; 't' moves them to a worker thread
+        vector <float> attract_x;       // hand_pts, split into x and y for the particles
+        vector <float> attract_y;
+        particleRenderer particle_renderer;     // 'm' toggles the persistently mapped buffer
         void setup_particle_system();
         void update_particle_system();
         void draw_particle_system();
         void reset_particle_system();
+        void resize_particle_system(int num);
 };
@@ -0,0 +1,153 @@
+#include "particleRenderer.h"
+
+//--------------------------------------------------------------
+void load_disc_sprite(ofTexture& tex, int size){
+
+    // white disc with a one pixel soft edge; ofSetColor tints it
+    ofPixels pix;
+    pix.allocate(size, size, OF_PIXELS_RGBA);
+    for (int y=0; y<size; y++){
+        for (int x=0; x<size; x++){
+            float d = ofDist(x + 0.5f, y + 0.5f, size / 2, size / 2);
+            pix.setColor(x, y, ofColor(255, ofClamp(size / 2 - d, 0, 1) * 255));
+        }
+    }
+
+    // point sprites need normalized texture coordinates
+    bool arb = ofGetUsingArbTex();
+    ofDisableArbTex();
+    tex.loadData(pix);
+    if (arb)
+        ofEnableArbTex();
+}
+
+//--------------------------------------------------------------
+particleRenderer::~particleRenderer(){
+    release_persistent();
+}
+
+//--------------------------------------------------------------
+void particleRenderer::setup(int max_particles){
+
+    load_disc_sprite(sprite);
+    allocate(max_particles);
+}
+
+//--------------------------------------------------------------
+bool particleRenderer::setPersistentMapping(bool enable){
+
+#ifndef TARGET_OPENGLES
+    if (enable && !glewIsSupported("GL_ARB_buffer_storage GL_ARB_sync")){
+        ofLogWarning("particleRenderer") << "persistent mapping needs GL_ARB_buffer_storage, using buffer uploads";
+        enable = false;
+    }
+#else
+    enable = false;
+#endif
+
+    if (enable != persistent){
+        persistent = enable;
+        allocate(capacity);
+    }
+    return persistent;
+}
+
+//--------------------------------------------------------------
+void particleRenderer::allocate(int max_particles){
+
+    capacity = max_particles;
+    vbo.clear();
+    release_persistent();
+    staging.clear();
+
+#ifndef TARGET_OPENGLES
+    if (persistent){
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr bytes = (GLsizeiptr)capacity * 2 * sizeof(float) * PARTICLE_RENDERER_REGIONS;
+
+        persistent_buffer.allocate();
+        persistent_buffer.bind(GL_ARRAY_BUFFER);
+        glBufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        mapped = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags);
+        persistent_buffer.unbind(GL_ARRAY_BUFFER);
+        region = 0;
+        if (mapped)
+            return;
+        ofLogWarning("particleRenderer") << "couldn't map the particle buffer, using buffer uploads";
+        persistent = false;
+        persistent_buffer = ofBufferObject();
+    }
+#endif
+
+    staging.resize(capacity * 2);
+    vbo.setVertexData(staging.data(), 2, capacity, GL_STREAM_DRAW, 2 * sizeof(float));
+}
+
+//--------------------------------------------------------------
+void particleRenderer::release_persistent(){
+
+#ifndef TARGET_OPENGLES
+    for (auto& fence : fences){
+        if (fence)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (mapped){
+        persistent_buffer.bind(GL_ARRAY_BUFFER);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        persistent_buffer.unbind(GL_ARRAY_BUFFER);
+        mapped = nullptr;
+    }
+#endif
+    persistent_buffer = ofBufferObject();
+}
+
+//--------------------------------------------------------------
+void particleRenderer::draw(const float* xs, const float* ys, int num, float radius){
+
+    if (num <= 0)
+        return;
+    if (num > capacity)
+        allocate(num);
+
+#ifndef TARGET_OPENGLES
+    if (mapped){
+        // wait until the GPU is done with the frame that last used this region
+        if (fences[region]){
+            glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+            glDeleteSync(fences[region]);
+            fences[region] = nullptr;
+        }
+
+        float* xy = mapped + (size_t)region * capacity * 2;
+        for (int i=0; i<num; i++){
+            xy[i * 2] = xs[i];
+            xy[i * 2 + 1] = ys[i];
+        }
+        vbo.setVertexBuffer(persistent_buffer, 2, 2 * sizeof(float), region * capacity * 2 * sizeof(float));
+    }
+    else
+#endif
+    {
+        float* xy = staging.data();
+        for (int i=0; i<num; i++){
+            xy[i * 2] = xs[i];
+            xy[i * 2 + 1] = ys[i];
+        }
+        vbo.updateVertexData(xy, num);
+    }
+
+    ofEnablePointSprites();
+    glPointSize(radius * 2);
+    sprite.bind();
+    vbo.draw(GL_POINTS, 0, num);
+    sprite.unbind();
+    ofDisablePointSprites();
+
+#ifndef TARGET_OPENGLES
+    if (mapped){
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region = (region + 1) % PARTICLE_RENDERER_REGIONS;
+    }
+#endif
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ofMain.h"
+
+/**
+ Draws all particles in one call.
+
+ The positions go into one ofVbo as interleaved x/y pairs and are drawn as
+ GL_POINTS with a round, anti-aliased point sprite, instead of one
+ ofDrawCircle (and one draw call) per particle. The colour is whatever is
+ current (ofSetColor) when draw() is called.
+
+ By default each frame is interleaved into a staging array and uploaded with
+ one buffer update. With setPersistentMapping(true) (needs
+ GL_ARB_buffer_storage) the buffer is mapped once and the positions are
+ written straight into it, skipping the copy. Three regions of the buffer
+ are used in turn, fenced, so the CPU never writes to the region the GPU is
+ still reading.
+ */
+
+#define PARTICLE_RENDERER_REGIONS 3
+
+// loads a white, anti-aliased disc for drawing round GL_POINTS as sprites
+void load_disc_sprite(ofTexture& tex, int size = 32);
+
+class particleRenderer{
+
+    public:
+        ~particleRenderer();
+
+        void setup(int max_particles);
+
+        // returns false (and stays on uploads) if the GL doesn't support it
+        bool setPersistentMapping(bool enable);
+        bool getPersistentMapping() const { return persistent; }
+
+        // grows the buffer if num is more than it holds
+        void draw(const float* xs, const float* ys, int num, float radius);
+
+    private:
+        void allocate(int max_particles);
+        void release_persistent();
+
+        ofVbo vbo;
+        ofTexture sprite;
+        int capacity = 0;
+
+        // copy path
+        vector<float> staging;
+
+        // persistently mapped path
+        bool persistent = false;
+        ofBufferObject persistent_buffer;
+        float* mapped = nullptr;
+        int region = 0;
+        GLsync fences[PARTICLE_RENDERER_REGIONS] = {};
+};
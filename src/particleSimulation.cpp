@@ -0,0 +1,190 @@
+#include "particleSimulation.h"
+#include "handTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//--------------------------------------------------------------
+particleSimulation::~particleSimulation(){
+    setThreaded(false);
+}
+
+//--------------------------------------------------------------
+int64_t particleSimulation::now_usec(){
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+void particleSimulation::setup(ParticleSystem* particles, float steps_per_second, int max_substeps){
+
+    setThreaded(false);
+    this->particles = particles;
+    // room for every slot, so changing the particle count doesn't allocate
+    for (Snapshot& snapshot : snapshots){
+        snapshot.x.reserve(particles->capacity());
+        snapshot.y.reserve(particles->capacity());
+    }
+    render_x.reserve(particles->capacity());
+    render_y.reserve(particles->capacity());
+    step_usec = std::max<int64_t>(1, 1000000 / steps_per_second);
+    this->max_substeps = std::max(1, max_substeps);
+    next_step_usec = 0;
+    step_count = 0;
+    latest = -1;
+    published = 0;
+}
+
+//--------------------------------------------------------------
+void particleSimulation::setThreaded(bool threaded){
+
+    if (threaded == isThreaded())
+        return;
+
+    if (threaded){
+        stopping = false;
+        worker = std::thread(&particleSimulation::worker_loop, this);
+    }
+    else{
+        stopping = true;
+        worker.join();
+    }
+}
+
+//--------------------------------------------------------------
+void particleSimulation::setFrame(const ParticleFrameContext& frame){
+
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    this->frame = frame;
+    attract_x.assign(frame.attract_x, frame.attract_x + frame.num_attractors);
+    attract_y.assign(frame.attract_y, frame.attract_y + frame.num_attractors);
+    emitters.assign(frame.emitters, frame.emitters + frame.num_emitters);
+}
+
+//--------------------------------------------------------------
+void particleSimulation::step(int64_t when_usec){
+
+    HAND_TRACE_SCOPE("particle step");
+
+    // take a copy of the inputs so the caller can keep changing them
+    ParticleFrameContext step_frame;
+    {
+        std::lock_guard<std::mutex> lock(frame_mutex);
+        step_frame = frame;
+        step_attract_x = attract_x;
+        step_attract_y = attract_y;
+        step_emitters = emitters;
+    }
+    step_frame.attract_x = step_attract_x.data();
+    step_frame.attract_y = step_attract_y.data();
+    step_frame.num_attractors = step_attract_x.size();
+    step_frame.emitters = step_emitters.data();
+    step_frame.num_emitters = step_emitters.size();
+    step_frame.dt = step_usec / 1000000.0f;
+
+    int64_t start = now_usec();
+    int slot;
+    {
+        std::lock_guard<std::mutex> lock(step_mutex);
+        step_frame.time = step_count * step_usec / 1000000.0;
+        particles->update(step_frame);
+        step_count++;
+
+        // the reader only ever blends the newest two, so the third is free
+        slot = (latest + 1) % 3;
+        Snapshot& snapshot = snapshots[slot];
+        snapshot.x.assign(particles->x.begin(), particles->x.begin() + particles->size());
+        snapshot.y.assign(particles->y.begin(), particles->y.begin() + particles->size());
+        snapshot.time_usec = when_usec;
+    }
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        latest = slot;
+        published++;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.steps++;
+    stats.step_usec += ((now_usec() - start) - stats.step_usec) / 16;
+}
+
+//--------------------------------------------------------------
+void particleSimulation::run_due_steps(int64_t now){
+
+    if (next_step_usec == 0)
+        next_step_usec = now;
+
+    int steps = 0;
+    while (next_step_usec <= now && steps < max_substeps){
+        step(next_step_usec);
+        next_step_usec += step_usec;
+        steps++;
+    }
+
+    // still behind after the budget: skip ahead rather than owe the steps
+    if (next_step_usec <= now){
+        int64_t skipped = (now - next_step_usec) / step_usec + 1;
+        next_step_usec += skipped * step_usec;
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats.dropped += skipped;
+    }
+}
+
+//--------------------------------------------------------------
+void particleSimulation::worker_loop(){
+
+    HAND_TRACE_THREAD("particle simulation");
+    while (!stopping){
+        run_due_steps(now_usec());
+        std::this_thread::sleep_for(std::chrono::microseconds(std::max<int64_t>(0, next_step_usec - now_usec())));
+    }
+}
+
+//--------------------------------------------------------------
+void particleSimulation::update(){
+
+    if (!particles)
+        return;
+
+    int64_t now = now_usec();
+    if (!isThreaded())
+        run_due_steps(now);
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    if (published == 0)
+        return;
+
+    // draw one step in the past, so there's always a step on either side
+    const Snapshot& cur = snapshots[latest];
+    const Snapshot& prev = snapshots[(latest + 2) % 3];
+    int n = cur.x.size();
+    render_x.resize(n);
+    render_y.resize(n);
+
+    float alpha = 1;
+    if (published > 1 && (int)prev.x.size() == n && cur.time_usec > prev.time_usec){
+        alpha = (float)(now - step_usec - prev.time_usec) / (cur.time_usec - prev.time_usec);
+        alpha = std::min(1.0f, std::max(0.0f, alpha));
+        // a particle that wrapped around the screen jumps instead of streaking across
+        for (int i=0; i<n; i++){
+            float dx = cur.x[i] - prev.x[i];
+            float dy = cur.y[i] - prev.y[i];
+            bool jump = fabsf(dx) > 100 || fabsf(dy) > 100;
+            render_x[i] = jump ? cur.x[i] : prev.x[i] + dx * alpha;
+            render_y[i] = jump ? cur.y[i] : prev.y[i] + dy * alpha;
+        }
+    }
+    else{
+        std::copy(cur.x.begin(), cur.x.end(), render_x.begin());
+        std::copy(cur.y.begin(), cur.y.end(), render_y.begin());
+    }
+
+    std::lock_guard<std::mutex> stats_lock(stats_mutex);
+    stats.alpha = alpha;
+}
+
+//--------------------------------------------------------------
+particleSimulation::Stats particleSimulation::getStats() const{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return stats;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ParticleSystem.h"
+
+/**
+ Runs a ParticleSystem at a fixed rate, independent of the frame rate.
+
+ The particle forces are tuned per step, so the simulation always advances
+ in steps of the same length (1/60 s by default) and the renderer draws a
+ blend of the last two steps for wherever the frame falls in between. If
+ the simulation falls behind, it runs at most max_substeps steps to catch
+ up and drops the rest, so one slow frame doesn't turn into a spiral of
+ ever heavier frames.
+
+ The steps run either inside update() or, with setThreaded(true), on a
+ worker thread that keeps stepping on its own schedule; update() then only
+ blends the latest two published steps. Either way, setFrame() passes the
+ latest inputs and getX()/getY() are what to draw.
+
+ While threaded, anything that changes the particles directly (setup,
+ reset) has to happen between lock() and unlock().
+ */
+
+class particleSimulation{
+
+    public:
+        ~particleSimulation();
+
+        void setup(ParticleSystem* particles, float steps_per_second = 60, int max_substeps = 4);
+
+        void setThreaded(bool threaded);
+        bool isThreaded() const { return worker.joinable(); }
+
+        // inputs for the following steps. frame.time is ignored: steps use the
+        // simulation clock, so the noise moves at the same speed at any frame rate
+        void setFrame(const ParticleFrameContext& frame);
+
+        // runs any steps that are due (when not threaded) and blends the last
+        // two for drawing now
+        void update();
+
+        // positions to draw
+        const float* getX() const { return render_x.data(); }
+        const float* getY() const { return render_y.data(); }
+        int size() const { return (int)render_x.size(); }
+
+        void lock() { step_mutex.lock(); }
+        void unlock() { step_mutex.unlock(); }
+
+        struct Stats{
+            uint64_t steps = 0;
+            uint64_t dropped = 0;       // steps skipped to catch up
+            float step_usec = 0;        // average cost of one step
+            float alpha = 0;            // how far the last frame was between two steps
+        };
+        Stats getStats() const;
+
+    private:
+        struct Snapshot{
+            std::vector<float> x;
+            std::vector<float> y;
+            int64_t time_usec = 0;      // when this state is due
+        };
+
+        static int64_t now_usec();
+        void step(int64_t when_usec);
+        void run_due_steps(int64_t now);
+        void worker_loop();
+
+        ParticleSystem* particles = nullptr;
+        int64_t step_usec = 16667;
+        int max_substeps = 4;
+        int64_t next_step_usec = 0;
+        uint64_t step_count = 0;
+
+        // latest inputs, copied by each step
+        std::mutex frame_mutex;
+        ParticleFrameContext frame;
+        std::vector<float> attract_x;
+        std::vector<float> attract_y;
+        std::vector<particleEmitter> emitters;
+
+        // held while a step runs
+        std::mutex step_mutex;
+        std::vector<float> step_attract_x;  // the step's copy of the attractors
+        std::vector<float> step_attract_y;
+        std::vector<particleEmitter> step_emitters;
+
+        // the last steps, written round robin; the newest two get blended
+        std::mutex snapshot_mutex;
+        Snapshot snapshots[3];
+        int latest = -1;
+        int published = 0;
+
+        std::vector<float> render_x;
+        std::vector<float> render_y;
+
+        std::thread worker;
+        std::atomic<bool> stopping{false};
+
+        mutable std::mutex stats_mutex;
+        Stats stats;
+};
@@ -0,0 +1,110 @@
+#include "receiverStats.h"
+#include <cstring>
+#include <cstdlib>
+
+//--------------------------------------------------------------
+void receiverStats::reset(){
+    started = false;
+    has_transit = false;
+    has_latency = false;
+    uint64_t resets = stats.resets;
+    stats = Stats();
+    stats.resets = resets;
+}
+
+//--------------------------------------------------------------
+bool receiverStats::record(const HandFrame& frame, int64_t receive_usec, int64_t receive_wall_usec){
+    
+    if (frame.has_sequence){
+        uint64_t seq = frame.sequence_id;
+        
+        // the sender started over (MyPassThroughCalculator numbers from 0 on
+        // every graph start) if the id jumps far back, or goes back at all on
+        // a frame sent after the newest one: a late frame was sent earlier
+        if (started && seq < highest_sequence &&
+            (seq + RECEIVER_STATS_WINDOW < highest_sequence ||
+             (frame.send_time_usec != 0 && highest_send_time_usec != 0 && frame.send_time_usec > highest_send_time_usec))){
+            reset();
+            stats.resets++;
+        }
+        
+        if (!started){
+            started = true;
+            first_sequence = seq;
+            highest_sequence = seq;
+            highest_send_time_usec = frame.send_time_usec;
+            memset(seen, 0, sizeof(seen));
+            test_and_set(seq);
+        }
+        else if (seq > highest_sequence){
+            // clear the window slots we skip over, they're now unseen ids
+            uint64_t gap = seq - highest_sequence;
+            if (gap >= RECEIVER_STATS_WINDOW){
+                memset(seen, 0, sizeof(seen));
+            }
+            else{
+                for (uint64_t s = highest_sequence + 1; s < seq; s++){
+                    uint64_t bit = s % RECEIVER_STATS_WINDOW;
+                    seen[bit / 64] &= ~(1ull << (bit % 64));
+                }
+            }
+            highest_sequence = seq;
+            highest_send_time_usec = frame.send_time_usec;
+            test_and_set(seq);
+        }
+        else{
+            // older than the newest: either a duplicate or a late (reordered)
+            // frame. Anything that fell out of the window can't be told apart
+            // from a duplicate, so it's dropped too.
+            if (highest_sequence - seq >= RECEIVER_STATS_WINDOW || seq < first_sequence || test_and_set(seq)){
+                stats.duplicates++;
+                return false;
+            }
+            stats.reordered++;
+        }
+        
+        stats.received++;
+        stats.expected = highest_sequence - first_sequence + 1;
+        stats.lost = stats.expected > stats.received ? stats.expected - stats.received : 0;
+        stats.loss_percent = 100.0f * stats.lost / stats.expected;
+    }
+    else{
+        stats.received++;
+    }
+    
+    // inter-arrival jitter: J += (|D| - J) / 16, where D is the change in
+    // transit time between consecutive frames. Clock offsets cancel out.
+    if (frame.send_time_usec != 0){
+        int64_t transit = receive_usec - frame.send_time_usec;
+        if (has_transit){
+            float d = (float)llabs(transit - last_transit);
+            stats.jitter_usec += (d - stats.jitter_usec) / 16.0f;
+        }
+        last_transit = transit;
+        has_transit = true;
+        
+        int64_t latency = receive_wall_usec - frame.send_time_usec;
+        stats.latency_usec = latency;
+        if (!has_latency){
+            stats.latency_avg_usec = latency;
+            stats.latency_min_usec = latency;
+            stats.latency_max_usec = latency;
+            has_latency = true;
+        }
+        else{
+            stats.latency_avg_usec += (latency - stats.latency_avg_usec) / 16.0f;
+            if (latency < stats.latency_min_usec) stats.latency_min_usec = latency;
+            if (latency > stats.latency_max_usec) stats.latency_max_usec = latency;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+bool receiverStats::test_and_set(uint64_t sequence_id){
+    uint64_t bit = sequence_id % RECEIVER_STATS_WINDOW;
+    uint64_t mask = 1ull << (bit % 64);
+    bool was_set = (seen[bit / 64] & mask) != 0;
+    seen[bit / 64] |= mask;
+    return was_set;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "handFrame.h"
+
+/**
+ Per-stream receive statistics, built from the sequence numbers and send
+ times the sender stamps on each message.
+ 
+ - loss: sequence numbers never seen (reordered frames that show up later
+   are not counted as lost)
+ - reordering and duplicates, tracked over a sliding window of sequence ids
+ - inter-arrival jitter, as defined for RTP (RFC 3550, section 6.4.1)
+ - one-way latency; only meaningful when sender and receiver share a clock
+   (i.e. the same host)
+ */
+
+#define RECEIVER_STATS_WINDOW 1024
+
+class receiverStats{
+
+    public:
+        struct Stats{
+            uint64_t received = 0;          // unique frames
+            uint64_t expected = 0;          // first..highest sequence id seen
+            uint64_t lost = 0;
+            float loss_percent = 0;
+            uint64_t reordered = 0;         // arrived after a higher sequence id
+            uint64_t duplicates = 0;
+            uint64_t resets = 0;            // sender restarted (id went back on a newer frame)
+            
+            float jitter_usec = 0;          // smoothed inter-arrival jitter
+            int64_t latency_usec = 0;       // last one-way latency
+            float latency_avg_usec = 0;     // smoothed
+            int64_t latency_min_usec = 0;
+            int64_t latency_max_usec = 0;
+        };
+    
+        void reset();
+    
+        // record an arriving frame: `receive_usec` is any monotonic local clock,
+        // `receive_wall_usec` the wall clock (for latency). Returns false if the
+        // frame is a duplicate and should be ignored.
+        bool record(const HandFrame& frame, int64_t receive_usec, int64_t receive_wall_usec);
+    
+        const Stats& getStats() const { return stats; }
+    
+    private:
+        bool test_and_set(uint64_t sequence_id);
+    
+        bool started = false;
+        uint64_t first_sequence = 0;
+        uint64_t highest_sequence = 0;
+        int64_t highest_send_time_usec = 0;     // send time of highest_sequence
+    
+        // ring of "seen" bits for the last RECEIVER_STATS_WINDOW sequence ids
+        uint64_t seen[RECEIVER_STATS_WINDOW / 64];
+    
+        bool has_transit = false;
+        int64_t last_transit = 0;
+        bool has_latency = false;
+    
+        Stats stats;
+};
@@ -0,0 +1,187 @@
+#include "shmRing.h"
+
+#ifndef _WIN32
+
+#include <chrono>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_RING_MAGIC 0x48524e47           // "HRNG"
+#define SHM_RING_VERSION 1
+#define SHM_RING_HEADER_SIZE 4096
+#define SHM_RING_WRAP 0xffffffffu           // record size meaning "continue at the start"
+
+// every record: size, source, the message, padded to 8 bytes
+struct shmRecord{
+    uint32_t size;
+    uint32_t source;
+};
+
+//--------------------------------------------------------------
+static inline uint64_t padded(uint64_t size){
+    return (sizeof(shmRecord) + size + 7) & ~(uint64_t)7;
+}
+
+//--------------------------------------------------------------
+shmRing::~shmRing(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool shmRing::setup(const std::string& name, size_t capacity){
+
+    close();
+    this->name = name;
+
+    size_t size = 4096;
+    while (size < capacity)
+        size <<= 1;
+
+    // whoever creates the ring sizes and initializes it...
+    bool created = true;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST){
+        created = false;
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0){
+        error = "shm_open " + name + ": " + strerror(errno);
+        return false;
+    }
+    if (created && ftruncate(fd, SHM_RING_HEADER_SIZE + size) != 0){
+        error = "ftruncate " + name + ": " + strerror(errno);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // ...and the other side waits until it has
+    struct stat st;
+    for (int i=0; !created && i<1000; i++){
+        if (fstat(fd, &st) == 0 && st.st_size > SHM_RING_HEADER_SIZE)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= SHM_RING_HEADER_SIZE){
+        error = name + " isn't a ring";
+        ::close(fd);
+        return false;
+    }
+    mapped_size = st.st_size;
+    void* mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED){
+        error = "mmap " + name + ": " + strerror(errno);
+        return false;
+    }
+    header = (Header*)mapping;
+    ring = (char*)mapping + SHM_RING_HEADER_SIZE;
+
+    if (created){
+        header->version = SHM_RING_VERSION;
+        header->capacity = mapped_size - SHM_RING_HEADER_SIZE;
+        header->head = 0;
+        header->tail = 0;
+        header->dropped = 0;
+        header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    }
+    else{
+        for (int i=0; i<1000 && header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC || header->version != SHM_RING_VERSION ||
+            header->capacity + SHM_RING_HEADER_SIZE != mapped_size){
+            error = name + " isn't a ring";
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void shmRing::close(bool remove_name){
+    if (header)
+        munmap(header, mapped_size);
+    header = nullptr;
+    ring = nullptr;
+    mapped_size = 0;
+    if (remove_name && !name.empty())
+        shm_unlink(name.c_str());
+}
+
+//--------------------------------------------------------------
+bool shmRing::send(const char* data, int size, int source){
+
+    if (!header || size < 0)
+        return false;
+
+    uint64_t capacity = header->capacity;
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    uint64_t tail = header->tail.load(std::memory_order_acquire);
+    uint64_t need = padded(size);
+
+    // a record never straddles the end: skip the rest of the ring instead
+    uint64_t offset = head & (capacity - 1);
+    uint64_t skip = capacity - offset < need ? capacity - offset : 0;
+    if (need > capacity / 2 || head + skip + need - tail > capacity){
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (skip){
+        ((shmRecord*)(ring + offset))->size = SHM_RING_WRAP;
+        head += skip;
+        offset = 0;
+    }
+
+    shmRecord* record = (shmRecord*)(ring + offset);
+    record->size = size;
+    record->source = source;
+    memcpy(record + 1, data, size);
+    header->head.store(head + need, std::memory_order_release);
+    return true;
+}
+
+//--------------------------------------------------------------
+int shmRing::receive(char* buffer, int size, int* source){
+
+    if (!header)
+        return 0;
+
+    uint64_t capacity = header->capacity;
+    uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    if (tail == head)
+        return 0;
+
+    uint64_t offset = tail & (capacity - 1);
+    const shmRecord* record = (const shmRecord*)(ring + offset);
+    if (capacity - offset < sizeof(shmRecord) || record->size == SHM_RING_WRAP){
+        tail += capacity - offset;
+        offset = 0;
+        record = (const shmRecord*)ring;
+    }
+
+    int n = record->size;
+    if (source)
+        *source = record->source;
+    if (n > size){
+        n = -1;
+    }
+    else{
+        memcpy(buffer, record + 1, n);
+    }
+    header->tail.store(tail + padded(record->size), std::memory_order_release);
+    return n;
+}
+
+//--------------------------------------------------------------
+uint64_t shmRing::getDropped() const{
+    return header ? header->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ Datagram-style ring buffer in POSIX shared memory, for passing hand
+ tracking messages between processes on one host without the socket layer.
+
+ One process writes and one reads. Each message keeps its boundaries and
+ carries a small source number, like the sender address of a datagram.
+ When the ring is full send() drops the message, as UDP would, rather than
+ block the sender. Either side can start first: setup() creates the ring if
+ it doesn't exist yet and attaches to it otherwise.
+
+ Not available on Windows.
+ */
+
+class shmRing{
+
+    public:
+        ~shmRing();
+
+        // name like "/hands"; capacity is rounded up to a power of two and
+        // only used by whoever creates the ring
+        bool setup(const std::string& name, size_t capacity = 4 << 20);
+        // remove_name: unlink the ring, so the next setup() starts afresh
+        void close(bool remove_name = false);
+        bool isSetup() const { return header != nullptr; }
+
+        // false if the ring is full (the message is dropped and counted)
+        bool send(const char* data, int size, int source = 0);
+
+        // the next message's size, 0 if there is none, -1 if it doesn't fit
+        // in `size` bytes (it is skipped)
+        int receive(char* buffer, int size, int* source = nullptr);
+
+        uint64_t getDropped() const;
+        const std::string& getError() const { return error; }
+
+    private:
+        // shared with the other process, at the start of the mapping
+        struct Header{
+            std::atomic<uint32_t> magic;
+            uint32_t version;
+            uint64_t capacity;
+            char pad0[48];
+            std::atomic<uint64_t> head;         // written up to here, by the sender
+            char pad1[56];
+            std::atomic<uint64_t> tail;         // read up to here, by the receiver
+            char pad2[56];
+            std::atomic<uint64_t> dropped;
+        };
+
+        Header* header = nullptr;
+        char* ring = nullptr;
+        size_t mapped_size = 0;
+        std::string name;
+        std::string error;
+};
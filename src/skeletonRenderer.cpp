@@ -0,0 +1,73 @@
+#include "skeletonRenderer.h"
+#include "particleRenderer.h"   // load_disc_sprite
+
+//--------------------------------------------------------------
+void skeletonRenderer::setup(const landmarkTopology& topology, int max_skeletons){
+
+    this->topology = topology;
+    num_landmarks = topology.num_landmarks;
+
+    load_disc_sprite(sprite);
+
+    vector<string> names;
+    for (int i=0; i<num_landmarks; i++)
+        names.push_back(ofToString(i));
+    labels.setup(names);
+
+    allocate(max_skeletons);
+}
+
+//--------------------------------------------------------------
+void skeletonRenderer::allocate(int max_skeletons){
+
+    capacity = max_skeletons;
+
+    // the same connections for every skeleton, offset to its landmarks
+    vector<ofIndexType> indices;
+    indices.reserve(capacity * topology.num_connections * 2);
+    for (int s=0; s<capacity; s++){
+        for (int i=0; i<topology.num_connections * 2; i++)
+            indices.push_back(s * num_landmarks + topology.connections[i]);
+    }
+
+    vbo.clear();
+    vector<ofVec3f> empty(capacity * num_landmarks);
+    vbo.setVertexData(&empty[0].x, 3, empty.size(), GL_STREAM_DRAW, sizeof(ofVec3f));
+    vbo.setIndexData(indices.data(), indices.size(), GL_STATIC_DRAW);
+}
+
+//--------------------------------------------------------------
+void skeletonRenderer::draw(const ofVec3f* points, int num_skeletons){
+
+    if (num_skeletons <= 0 || num_landmarks == 0)
+        return;
+    if (num_skeletons > capacity)
+        allocate(num_skeletons);
+
+    int num_points = num_skeletons * num_landmarks;
+    vbo.updateVertexData(&points[0].x, num_points);
+
+    ofPushStyle();
+
+    ofSetColor(line_color);
+    ofSetLineWidth(line_width);
+    vbo.drawElements(GL_LINES, num_skeletons * topology.num_connections * 2);
+
+    ofSetColor(point_color);
+    ofEnablePointSprites();
+    glPointSize(point_size);
+    sprite.bind();
+    vbo.draw(GL_POINTS, 0, num_points);
+    sprite.unbind();
+    ofDisablePointSprites();
+
+    if (show_labels){
+        labels.clear();
+        for (int i=0; i<num_points; i++)
+            labels.add(i % num_landmarks, points[i].x + 10, points[i].y + 10 - LABEL_ATLAS_BASELINE);
+        ofSetColor(label_color);
+        labels.draw();
+    }
+
+    ofPopStyle();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ofMain.h"
+#include "labelAtlas.h"
+#include "landmarkTopology.h"
+
+/**
+ Draws any number of skeletons that share one topology (e.g. hands) with two
+ draw calls: the connections as indexed GL_LINES and the landmarks as point
+ sprites, plus one more for the labels if they're on.
+
+ The index buffer for all skeletons is built once in setup() from the
+ topology's connection table; each frame only the landmark positions are
+ uploaded, in one buffer update.
+ */
+
+class skeletonRenderer{
+
+    public:
+        void setup(const landmarkTopology& topology, int max_skeletons = 2);
+
+        // points holds num_landmarks points per skeleton, one skeleton after the other
+        void draw(const ofVec3f* points, int num_skeletons);
+
+        ofColor line_color = ofColor(ofColor::magenta, 120);
+        float line_width = 3;
+        ofColor point_color = ofColor(ofColor::cyan, 120);
+        float point_size = 15;
+        ofColor label_color = ofColor::black;
+        bool show_labels = true;            // landmark numbers, next to each point
+
+    private:
+        void allocate(int max_skeletons);
+
+        landmarkTopology topology = {};
+        int num_landmarks = 0;
+        int capacity = 0;                   // skeletons the buffers hold
+
+        ofVbo vbo;
+        ofTexture sprite;
+        labelAtlas labels;
+};
@@ -0,0 +1,122 @@
+#include "spatialGrid.h"
+#include <algorithm>
+#include <cfloat>
+
+//--------------------------------------------------------------
+void spatialGrid::setup(float cell_size, int num_buckets){
+
+    this->cell_size = cell_size;
+    inv_cell_size = 1.0f / cell_size;
+
+    uint32_t n = 1;
+    while (n < (uint32_t)std::max(num_buckets, 1))
+        n <<= 1;
+    bucket_mask = n - 1;
+
+    clear();
+}
+
+//--------------------------------------------------------------
+void spatialGrid::clear(){
+    bucket_start.assign(bucket_mask + 2, 0);
+    bucket.clear();
+    slot.clear();
+    index.clear();
+    sorted_x.clear();
+    sorted_y.clear();
+}
+
+//--------------------------------------------------------------
+void spatialGrid::build(const float* xs, const float* ys, int num){
+
+    // same points, all still in the same cell: only the coordinates move
+    if (num == size() && num > 0){
+        bool moved = false;
+        for (int i=0; i<num && !moved; i++)
+            moved = bucket_of(cell_of(xs[i]), cell_of(ys[i])) != bucket[i];
+        if (!moved){
+            for (int i=0; i<num; i++){
+                sorted_x[slot[i]] = xs[i];
+                sorted_y[slot[i]] = ys[i];
+            }
+            update_bounds(xs, ys, num);
+            stats.updates++;
+            return;
+        }
+    }
+
+    if (bucket_start.size() != bucket_mask + 2)
+        bucket_start.resize(bucket_mask + 2);
+    std::fill(bucket_start.begin(), bucket_start.end(), 0);
+    bucket.resize(num);
+    slot.resize(num);
+    index.resize(num);
+    sorted_x.resize(num);
+    sorted_y.resize(num);
+
+    // count, prefix sum, scatter (stable, so each bucket stays in index order)
+    for (int i=0; i<num; i++){
+        bucket[i] = bucket_of(cell_of(xs[i]), cell_of(ys[i]));
+        bucket_start[bucket[i] + 1]++;
+    }
+    for (size_t b=1; b<bucket_start.size(); b++)
+        bucket_start[b] += bucket_start[b - 1];
+
+    std::vector<int>& next = scratch;
+    next.assign(bucket_start.begin(), bucket_start.end() - 1);
+    for (int i=0; i<num; i++){
+        int k = next[bucket[i]]++;
+        slot[i] = k;
+        index[k] = i;
+        sorted_x[k] = xs[i];
+        sorted_y[k] = ys[i];
+    }
+    update_bounds(xs, ys, num);
+    stats.builds++;
+}
+
+//--------------------------------------------------------------
+void spatialGrid::update_bounds(const float* xs, const float* ys, int num){
+    min_x = min_y = FLT_MAX;
+    max_x = max_y = -FLT_MAX;
+    for (int i=0; i<num; i++){
+        min_x = std::min(min_x, xs[i]);
+        max_x = std::max(max_x, xs[i]);
+        min_y = std::min(min_y, ys[i]);
+        max_y = std::max(max_y, ys[i]);
+    }
+}
+
+//--------------------------------------------------------------
+int spatialGrid::nearest(float px, float py, float radius, float& dist_sq) const{
+
+    int best = -1;
+    float best_d = FLT_MAX;
+    for_each_in_radius(px, py, radius, [&](int i, float d){
+        if (d < best_d || (d == best_d && i < best)){
+            best_d = d;
+            best = i;
+        }
+    });
+    dist_sq = best_d;
+    return best;
+}
+
+//--------------------------------------------------------------
+void spatialGrid::nearest(const float* px, const float* py, int n, float radius, int* closest, float* dist_sq) const{
+
+    // test the bounds here so the common miss doesn't cost a call
+    float x0 = min_x - radius, x1 = max_x + radius;
+    float y0 = min_y - radius, y1 = max_y + radius;
+    bool empty = index.empty();
+
+    for (int i=0; i<n; i++){
+        if (empty || px[i] < x0 || px[i] > x1 || py[i] < y0 || py[i] > y1){
+            closest[i] = -1;
+            dist_sq[i] = FLT_MAX;
+        }
+        else{
+            closest[i] = nearest(px[i], py[i], radius, dist_sq[i]);
+        }
+    }
+}
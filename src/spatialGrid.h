@@ -0,0 +1,129 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ Uniform grid over a set of 2d points, hashed into a fixed number of buckets
+ so it doesn't need to know the bounds up front.
+
+ build() bucket-sorts the points (a counting sort, no allocations once the
+ buffers have grown) and keeps a sorted copy of their coordinates next to
+ their original index, so a query only walks a few short contiguous runs.
+ If the same number of points comes back and none of them changed cell,
+ build() just overwrites the coordinates in place.
+
+ Works the same whether the points are the hand landmarks the particles are
+ pushed away from, or the particles themselves (for particle-particle forces).
+ Queries don't modify the grid and can run on several threads at once.
+ */
+
+class spatialGrid{
+
+    public:
+        // cell_size should be about the query radius; num_buckets is rounded
+        // up to a power of two
+        void setup(float cell_size, int num_buckets = 4096);
+
+        void build(const float* xs, const float* ys, int num);
+        void clear();
+
+        int size() const { return (int)index.size(); }
+        float getCellSize() const { return cell_size; }
+
+        // index of the closest point within `radius` of (px, py), or -1; ties
+        // go to the lower index. dist_sq gets the squared distance.
+        int nearest(float px, float py, float radius, float& dist_sq) const;
+
+        // the same for a batch of n points, laid out like find_nearest_attractors()
+        void nearest(const float* px, const float* py, int n, float radius, int* closest, float* dist_sq) const;
+
+        // calls fn(index, dist_sq) for every point within `radius` of (px, py)
+        template <class F>
+        void for_each_in_radius(float px, float py, float radius, F&& fn) const;
+
+        struct Stats{
+            int builds = 0;             // full bucket sorts
+            int updates = 0;            // in place coordinate updates
+        };
+        const Stats& getStats() const { return stats; }
+
+    private:
+        int cell_of(float v) const {
+            float t = v * inv_cell_size;
+            int c = (int)t;
+            return c - (t < c);         // floor, without the libm call
+        }
+        uint32_t bucket_of(int cx, int cy) const {
+            return ((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u) & bucket_mask;
+        }
+
+        void update_bounds(const float* xs, const float* ys, int num);
+
+        float cell_size = 50;
+        float inv_cell_size = 1.0f / 50;
+        uint32_t bucket_mask = 4095;
+
+        std::vector<int> bucket_start;      // num_buckets + 1 offsets into the sorted arrays
+        std::vector<uint32_t> bucket;       // bucket of each input point
+        std::vector<int> slot;              // where each input point sits in the sorted arrays
+        std::vector<int> index;             // sorted: original index
+        std::vector<float> sorted_x;
+        std::vector<float> sorted_y;
+        std::vector<int> scratch;
+        float min_x = 0, max_x = 0, min_y = 0, max_y = 0;     // bounds of the points
+
+        Stats stats;
+};
+
+//--------------------------------------------------------------
+template <class F>
+void spatialGrid::for_each_in_radius(float px, float py, float radius, F&& fn) const{
+
+    // most queries are nowhere near any point
+    if (index.empty() || px + radius < min_x || px - radius > max_x || py + radius < min_y || py - radius > max_y)
+        return;
+
+    int cx0 = cell_of(px - radius), cx1 = cell_of(px + radius);
+    int cy0 = cell_of(py - radius), cy1 = cell_of(py + radius);
+    float r2 = radius * radius;
+
+    // a huge query box: cheaper to look at every point
+    if ((int64_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > 64){
+        for (int k=0; k<size(); k++){
+            float dx = sorted_x[k] - px;
+            float dy = sorted_y[k] - py;
+            float d2 = dx * dx + dy * dy;
+            if (d2 < r2)
+                fn(index[k], d2);
+        }
+        return;
+    }
+
+    // neighbouring cells can hash to the same bucket; only visit it once
+    uint32_t visited[64];
+    int num_visited = 0;
+    for (int cy=cy0; cy<=cy1; cy++){
+        for (int cx=cx0; cx<=cx1; cx++){
+            uint32_t b = bucket_of(cx, cy);
+            int begin = bucket_start[b];
+            int end = bucket_start[b + 1];
+            if (begin == end)
+                continue;
+            bool seen = false;
+            for (int v=0; v<num_visited; v++)
+                seen |= visited[v] == b;
+            if (seen)
+                continue;
+            visited[num_visited++] = b;
+            
+            for (int k=begin; k<end; k++){
+                float dx = sorted_x[k] - px;
+                float dy = sorted_y[k] - py;
+                float d2 = dx * dx + dy * dy;
+                if (d2 < r2)
+                    fn(index[k], d2);
+            }
+        }
+    }
+}
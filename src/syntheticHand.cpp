@@ -0,0 +1,81 @@
+#include "syntheticHand.h"
+#include <algorithm>
+#include <cmath>
+
+// per finger (thumb first): knuckle position, splay angle and bone lengths
+struct syntheticFinger{
+    float base_x, base_y, angle;
+    float bones[3];
+};
+static const syntheticFinger FINGERS[5] = {
+    {-0.25f, 0.20f, -0.90f, {0.40f, 0.32f, 0.25f}},
+    {-0.22f, 0.90f, -0.12f, {0.40f, 0.24f, 0.20f}},
+    {-0.02f, 0.95f,  0.00f, {0.45f, 0.28f, 0.22f}},
+    { 0.17f, 0.88f,  0.10f, {0.42f, 0.26f, 0.20f}},
+    { 0.33f, 0.75f,  0.24f, {0.32f, 0.20f, 0.18f}},
+};
+
+//--------------------------------------------------------------
+syntheticHand::syntheticHand(uint32_t seed) : rng(seed){
+    std::uniform_real_distribution<float> unit(0, 1);
+    for (auto& p : phase)
+        p = unit(rng) * 6.2831853f;
+    speed = 0.6f + 0.8f * unit(rng);
+}
+
+//--------------------------------------------------------------
+void syntheticHand::pose(double t, HandFrame& frame){
+
+    float s = speed * t;
+    float cx = 0.5f + 0.25f * sinf(0.31f * s + phase[0]);
+    float cy = 0.55f + 0.2f * sinf(0.23f * s + phase[1]);
+    float scale = 0.11f + 0.02f * sinf(0.17f * s + phase[2]);
+    float turn = 0.5f * sinf(0.13f * s + phase[3]);
+    float c = cosf(turn), sn = sinf(turn);
+
+    float hx[NUM_HAND_LANDMARKS], hy[NUM_HAND_LANDMARKS], hz[NUM_HAND_LANDMARKS];
+    hx[0] = hy[0] = hz[0] = 0;
+    for (int f=0; f<5; f++){
+        const syntheticFinger& finger = FINGERS[f];
+        // each finger opens and closes on its own cycle
+        float curl = 0.5f + 0.5f * sinf(1.7f * s + phase[4] + 0.6f * f + (f == 0 ? phase[5] : 0));
+        float px = finger.base_x, py = finger.base_y, pz = 0;
+        float angle = finger.angle;
+        int first = 1 + 4 * f;
+        hx[first] = px;
+        hy[first] = py;
+        hz[first] = 0;
+        for (int j=0; j<3; j++){
+            // bending a finger folds it toward the palm (and the camera);
+            // the thumb swings across instead
+            float bend = curl * (f == 0 ? 0.35f : 0.9f) * (j + 1) / 2.0f;
+            float len = finger.bones[j] * cosf(bend);
+            angle += f == 0 ? 0.3f * curl : 0;
+            px += len * sinf(angle);
+            py += len * cosf(angle);
+            pz -= finger.bones[j] * sinf(bend);
+            hx[first + j + 1] = px;
+            hy[first + j + 1] = py;
+            hz[first + j + 1] = pz;
+        }
+    }
+
+    // into the image: rotate, scale, flip y (image y points down), add noise
+    float min_x = 1, min_y = 1, max_x = 0, max_y = 0;
+    frame.num_landmarks = NUM_HAND_LANDMARKS;
+    for (int i=0; i<NUM_HAND_LANDMARKS; i++){
+        frame.x[i] = cx + scale * (c * hx[i] - sn * hy[i]) + jitter(rng);
+        frame.y[i] = cy - scale * (sn * hx[i] + c * hy[i]) + jitter(rng);
+        frame.z[i] = scale * hz[i] * 0.5f;
+        min_x = std::min(min_x, frame.x[i]);
+        max_x = std::max(max_x, frame.x[i]);
+        min_y = std::min(min_y, frame.y[i]);
+        max_y = std::max(max_y, frame.y[i]);
+    }
+    frame.has_rect = true;
+    frame.rect_x_center = (min_x + max_x) / 2;
+    frame.rect_y_center = (min_y + max_y) / 2;
+    frame.rect_width = (max_x - min_x) * 1.2f;
+    frame.rect_height = (max_y - min_y) * 1.2f;
+    frame.rect_rotation = turn;
+}
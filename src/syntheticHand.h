@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include "handFrame.h"
+
+/**
+ A plausible moving hand, for exercising the pipeline without a camera.
+
+ The wrist drifts around the image and the hand turns, while each finger
+ opens and closes on its own cycle, with a little tracking noise on top.
+ The pose is built in hand space (wrist at the origin, fingers pointing up,
+ one unit ~ the palm length) from bone lengths and joint angles, then
+ placed in normalized image coordinates with a rect around it. Hands with
+ different seeds move differently; the same seed gives the same motion.
+ */
+
+class syntheticHand{
+
+    public:
+        syntheticHand(uint32_t seed = 1);
+
+        // the pose at t seconds: landmarks (in MediaPipe's order, see
+        // landmarkTopology.h) and rect. Leaves the frame's timing fields alone.
+        void pose(double t, HandFrame& frame);
+
+    private:
+        std::mt19937 rng;
+        std::normal_distribution<float> jitter{0, 0.0015f};
+        float phase[6];
+        float speed;
+};
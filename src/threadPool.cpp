@@ -0,0 +1,152 @@
+#include "threadPool.h"
+#include <algorithm>
+
+//--------------------------------------------------------------
+static inline uint64_t pack(uint32_t begin, uint32_t end){
+    return ((uint64_t)begin << 32) | end;
+}
+
+//--------------------------------------------------------------
+threadPool::~threadPool(){
+    close();
+}
+
+//--------------------------------------------------------------
+void threadPool::setup(int num_threads){
+    
+    close();
+    
+    if (num_threads <= 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    
+    stopping = false;
+    ranges.reset(new Range[num_threads]);
+    for (int i=0; i<num_threads; i++)
+        ranges[i].chunks = 0;
+    for (int i=0; i<num_threads - 1; i++)
+        workers.emplace_back(&threadPool::worker_loop, this, i);
+}
+
+//--------------------------------------------------------------
+void threadPool::close(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    start_cv.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+//--------------------------------------------------------------
+void threadPool::run(int n, int chunk, chunk_function fn, void* context){
+    
+    if (n <= 0)
+        return;
+    if (chunk <= 0)
+        chunk = n;
+    int num_chunks = (n + chunk - 1) / chunk;
+    
+    // nothing to share: just run it here
+    if (workers.empty() || num_chunks == 1){
+        for (int c=0; c<num_chunks; c++)
+            fn(context, c * chunk, std::min(n, (c + 1) * chunk));
+        return;
+    }
+    
+    // deal the chunks out evenly
+    int num_threads = getNumThreads();
+    for (int i=0; i<num_threads; i++){
+        uint32_t begin = (uint32_t)((int64_t)num_chunks * i / num_threads);
+        uint32_t end = (uint32_t)((int64_t)num_chunks * (i + 1) / num_threads);
+        ranges[i].chunks.store(pack(begin, end), std::memory_order_relaxed);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job_fn = fn;
+        job_context = context;
+        job_n = n;
+        job_chunk = chunk;
+        active = (int)workers.size();
+        generation++;
+    }
+    start_cv.notify_all();
+    
+    // the caller takes the last share
+    work(num_threads - 1);
+    
+    // wait until every worker has let go of the job
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this]{ return active == 0; });
+}
+
+//--------------------------------------------------------------
+void threadPool::worker_loop(int index){
+    
+    uint64_t seen = 0;
+    while (true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&]{ return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        
+        work(index);
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--active == 0)
+            done_cv.notify_one();
+    }
+}
+
+//--------------------------------------------------------------
+void threadPool::work(int index){
+    
+    while (true){
+        int c = pop_front(index);
+        if (c < 0)
+            c = steal_back(index);
+        if (c < 0)
+            return;
+        job_fn(job_context, c * job_chunk, std::min(job_n, (c + 1) * job_chunk));
+    }
+}
+
+//--------------------------------------------------------------
+int threadPool::pop_front(int index){
+    
+    std::atomic<uint64_t>& chunks = ranges[index].chunks;
+    uint64_t current = chunks.load(std::memory_order_acquire);
+    while (true){
+        uint32_t begin = (uint32_t)(current >> 32);
+        uint32_t end = (uint32_t)current;
+        if (begin >= end)
+            return -1;
+        if (chunks.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel))
+            return (int)begin;
+    }
+}
+
+//--------------------------------------------------------------
+int threadPool::steal_back(int index){
+    
+    // look at the other threads in turn, starting with our neighbour
+    int num_threads = getNumThreads();
+    for (int k=1; k<num_threads; k++){
+        std::atomic<uint64_t>& chunks = ranges[(index + k) % num_threads].chunks;
+        uint64_t current = chunks.load(std::memory_order_acquire);
+        while (true){
+            uint32_t begin = (uint32_t)(current >> 32);
+            uint32_t end = (uint32_t)current;
+            if (begin >= end)
+                break;
+            if (chunks.compare_exchange_weak(current, pack(begin, end - 1), std::memory_order_acq_rel))
+                return (int)(end - 1);
+        }
+    }
+    return -1;
+}
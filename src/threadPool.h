@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ Persistent pool of worker threads for data-parallel loops.
+ 
+ parallel_for() cuts [0, n) into fixed-size chunks and deals them out
+ evenly; each thread (the caller included) works through its own share from
+ the front, then steals from the back of the others' when it runs out. The
+ call returns once every chunk is done.
+ 
+ Which thread runs a chunk is not fixed, so `fn` must only write to its own
+ [begin, end) range if the result is to be deterministic.
+ */
+
+class threadPool{
+
+    public:
+        ~threadPool();
+    
+        // start num_threads - 1 workers (the caller is the last thread);
+        // 0 uses one thread per core
+        void setup(int num_threads = 0);
+        void close();
+    
+        int getNumThreads() const { return (int)workers.size() + 1; }
+    
+        // calls fn(begin, end) for each chunk of [0, n), in parallel
+        template <class F>
+        void parallel_for(int n, int chunk, F&& fn){
+            run(n, chunk, [](void* context, int begin, int end){ (*(typename std::remove_reference<F>::type*)context)(begin, end); }, &fn);
+        }
+    
+    private:
+        typedef void (*chunk_function)(void* context, int begin, int end);
+    
+        void run(int n, int chunk, chunk_function fn, void* context);
+        void worker_loop(int index);
+        void work(int index);
+        int pop_front(int index);
+        int steal_back(int index);
+    
+        // remaining chunks [begin, end) of one thread, packed into one atomic
+        // so the owner and thieves can both update it with a CAS. Padded to
+        // a cache line so neighbouring threads don't fight over it.
+        struct Range{
+            std::atomic<uint64_t> chunks;
+            char pad[64 - sizeof(std::atomic<uint64_t>)];
+        };
+    
+        std::vector<std::thread> workers;
+        std::unique_ptr<Range[]> ranges;
+    
+        // the job being run
+        chunk_function job_fn = nullptr;
+        void* job_context = nullptr;
+        int job_n = 0;
+        int job_chunk = 0;
+    
+        std::mutex mutex;
+        std::condition_variable start_cv;
+        std::condition_variable done_cv;
+        uint64_t generation = 0;
+        int active = 0;
+        bool stopping = false;
+};
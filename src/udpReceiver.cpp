@@ -0,0 +1,97 @@
+#include "udpReceiver.h"
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+//--------------------------------------------------------------
+udpReceiver::~udpReceiver(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool udpReceiver::setup(int port, bool blocking, int receive_buffer_size){
+    
+    close();
+    
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0){
+        error = std::string("socket: ") + strerror(errno);
+        return false;
+    }
+    
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (receive_buffer_size > 0)
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer_size, sizeof(receive_buffer_size));
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+    if (bind(fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0){
+        error = "bind to port " + std::to_string(port) + ": " + strerror(errno);
+        close();
+        return false;
+    }
+    
+    if (!blocking)
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    
+    this->port = port;
+    return true;
+}
+
+//--------------------------------------------------------------
+void udpReceiver::close(){
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+}
+
+//--------------------------------------------------------------
+int udpReceiver::receive(char* buffer, int size){
+    
+    struct sockaddr_in from;
+    socklen_t from_size = sizeof(from);
+    ssize_t n = recvfrom(fd, buffer, size, 0, (struct sockaddr *) &from, &from_size);
+    if (n < 0){
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        error = std::string("recv: ") + strerror(errno);
+        return -1;
+    }
+    sender_address = from.sin_addr.s_addr;
+    sender_port = from.sin_port;
+    return (int)n;
+}
+
+//--------------------------------------------------------------
+bool udpReceiver::hasPending() const{
+    struct pollfd p = {fd, POLLIN, 0};
+    return poll(&p, 1, 0) > 0;
+}
+
+//--------------------------------------------------------------
+bool udpReceiver::reply(const char* data, int size){
+    
+    if (sender_port == 0)
+        return false;
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = sender_port;
+    to.sin_addr.s_addr = sender_address;
+    return sendto(fd, data, size, 0, (const struct sockaddr *) &to, sizeof(to)) == size;
+}
+
+#endif
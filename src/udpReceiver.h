@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ Minimal UDP socket for receiving hand tracking datagrams with plain POSIX
+ sockets, for code that runs without openFrameworks (ofApp itself uses
+ ofxUDPManager). Not available on Windows.
+ */
+
+class udpReceiver{
+
+    public:
+        ~udpReceiver();
+    
+        // bind to `port` on all interfaces; optionally enlarge the kernel buffer
+        bool setup(int port, bool blocking = false, int receive_buffer_size = 0);
+        void close();
+    
+        // returns the datagram size, 0 if nothing is waiting (non-blocking)
+        // or -1 on error
+        int receive(char* buffer, int size);
+        // whether another datagram is already waiting
+        bool hasPending() const;
+        // send back to whoever the last datagram came from
+        bool reply(const char* data, int size);
+    
+        int getFd() const { return fd; }
+        int getPort() const { return port; }
+        const std::string& getError() const { return error; }
+    
+    private:
+        int fd = -1;
+        int port = 0;
+        uint32_t sender_address = 0;        // network byte order
+        uint16_t sender_port = 0;
+        std::string error;
+};